@@ -0,0 +1,110 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libcmaes/cmaes.h>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <gflags/gflags.h>
+
+#ifndef GFLAGS_GFLAGS_H_
+namespace gflags = google;
+#endif  // GFLAGS_GFLAGS_H_
+
+using namespace libcmaes;
+
+DEFINE_int32(dim,10,"problem dimension");
+DEFINE_int32(calls,1000000,"progress function calls timed per mode");
+
+FitFunc fsphere = [](const double *x, const int N)
+{
+  double val = 0.0;
+  for (int i=0;i<N;i++)
+    val += x[i]*x[i];
+  return val;
+};
+
+static int evaluations = 0;
+
+// counts its evaluations, so that skipped log arguments can be told apart.
+double counted(const double &v)
+{
+  ++evaluations;
+  return v;
+}
+
+// nanoseconds per call of the progress function.
+double time_pfunc(const ProgressFunc<CMAParameters<>,CMASolutions> &pfunc,
+		  const CMAParameters<> &cmaparams, const CMASolutions &cmasols, const int &calls)
+{
+  std::chrono::steady_clock::time_point tstart = std::chrono::steady_clock::now();
+  for (int c=0;c<calls;c++)
+    pfunc(cmaparams,cmasols);
+  return std::chrono::duration<double,std::nano>(std::chrono::steady_clock::now()-tstart).count() / calls;
+}
+
+// times the default progress function, called once per generation, against a progress
+// function doing nothing: in quiet mode, both should cost the same.
+int main(int argc, char *argv[])
+{
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  std::vector<double> x0(FLAGS_dim,1.0);
+  CMAParameters<> cmaparams(x0,0.5);
+  CMASolutions cmasols = cmaes<>(fsphere,cmaparams);
+
+  ProgressFunc<CMAParameters<>,CMASolutions> noop = [](const CMAParameters<> &cmaparams, const CMASolutions &cmasols)
+    {
+      (void)cmaparams;
+      (void)cmasols;
+      return 0;
+    };
+  ProgressFunc<CMAParameters<>,CMASolutions> pfunc = CMAStrategy<CovarianceUpdate>::_defaultPFunc;
+  ProgressFunc<CMAParameters<>,CMASolutions> counting = [](const CMAParameters<> &cmaparams, const CMASolutions &cmasols)
+    {
+      LOG_IF(INFO,!cmaparams.quiet()) << "f-value=" << counted(cmasols.best_candidate().get_fvalue()) << std::endl;
+      return 0;
+    };
+
+  cmaparams.set_quiet(true);
+  double noop_ns = time_pfunc(noop,cmaparams,cmasols,FLAGS_calls);
+  double quiet_ns = time_pfunc(pfunc,cmaparams,cmasols,FLAGS_calls);
+  time_pfunc(counting,cmaparams,cmasols,FLAGS_calls);
+  int quiet_evaluations = evaluations;
+
+  // verbose output goes to a string, to time formatting rather than the terminal.
+  std::ostringstream sink;
+  std::streambuf *coutbuf = std::cout.rdbuf(sink.rdbuf());
+  cmaparams.set_quiet(false);
+  int verbose_calls = std::max(1,FLAGS_calls / 100);
+  double verbose_ns = time_pfunc(pfunc,cmaparams,cmasols,verbose_calls);
+  cmaparams.set_log_every(100);
+  double every_ns = time_pfunc(pfunc,cmaparams,cmasols,FLAGS_calls);
+  std::cout.rdbuf(coutbuf);
+
+  std::cout << "{\"calls\":" << FLAGS_calls
+	    << ",\"noop_ns\":" << noop_ns
+	    << ",\"quiet_ns\":" << quiet_ns
+	    << ",\"quiet_arguments_evaluated\":" << quiet_evaluations
+	    << ",\"verbose_ns\":" << verbose_ns
+	    << ",\"log_every_100_ns\":" << every_ns
+	    << "}" << std::endl;
+  return quiet_evaluations == 0 ? 0 : 1;
+}
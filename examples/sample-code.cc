@@ -21,9 +21,16 @@
 #include <libcmaes/cmaes.h>
 #include <iostream>
 #include "simulator/Generator.h"
-#include <thread>
+#include "simulator/PaletteBatch.h"
+#include "simulator/FixedNeuralNetwork.h"
 #include <mutex>
-#include "simulator/BestSolution.h"
+#include <memory>
+#include <limits>
+#include <future>
+#include <chrono>
+#include "simulator/InstanceCorpus.h"
+#include "simulator/NetworkWeights.h"
+#include "simulator/Validation.h"
 
 using namespace libcmaes;
 
@@ -43,58 +50,44 @@ unsigned int getNumberOfNeuralNetworkWeights(const std::vector<int> &nodesInLaye
 //
 //FitFunc fContainer = [nodesInLayersCount]
 
-std::vector<std::vector<std::vector<float>>>
-getWeightsMatrix(const std::vector<int> &neuronsInLayersCount, const double *x) {
-    std::vector<std::vector<std::vector<float>>> result;
-
-    int index = 0;
-
-    int size = int(neuronsInLayersCount.size()) - 1;
-    for (int layer = 0; layer < size; layer++) {
-        int neuronsCountCurrentLayer = neuronsInLayersCount[layer] + 1; // +1 because of bias
-        int neuronsCountNextLayer = neuronsInLayersCount[layer + 1];
-        result.emplace_back(neuronsCountCurrentLayer, std::vector<float>(neuronsCountNextLayer));
-        for (int neuronNumber = 0; neuronNumber < neuronsCountCurrentLayer; neuronNumber++) {
-            for (int weightNumber = 0; weightNumber < neuronsCountNextLayer; index++, weightNumber++)
-                result[layer][neuronNumber][weightNumber] = x[index];
+// packs the instances of a candidate in lock-step on the calling thread, with whichever network visitNetwork() picks
+struct MeanSimulation {
+    using result_type = std::pair<bool, double>;
+
+    const InstancePool &instances;
+    int experimentsNumber;
+    int levelsNumber;
+    double cutoff;
+
+    template<class TNetwork>
+    result_type operator()(const TNetwork &network) const {
+        BasicPaletteBatch<TNetwork> batch(network, unsigned(levelsNumber));
+        for (int i = 0; i < experimentsNumber; ++i) {
+            const Instance &instance = instances[i];
+            batch.add(instance.paletteSize.first, instance.paletteSize.second, instance.items);
         }
+        return batch.performMeanSimulation(cutoff); //partial mean below cutoff when stopped early
     }
-
-    return result;
-}
+};
 
 void
 print_result_to_file(const CMASolutions &cmasols, const std::vector<int> &nodesInLayersCount, std::string filename) {
-    std::ofstream outputFile(filename);
-    if (outputFile.is_open()) {
-        outputFile << "#include <vector>" << std::endl;
-
-        std::string resultWeights = "std::vector<double> resultWeights = {";
-        for (auto x: cmasols.best_candidate().get_x())
-            resultWeights += std::to_string(x) + ",";
-        if (!resultWeights.empty())
-            resultWeights = resultWeights.substr(0, resultWeights.size() - 1);
-        resultWeights += "};";
-        outputFile << resultWeights << std::endl;
-
-        outputFile << "double feval = " << cmasols.best_candidate().get_fvalue() << ";" << std::endl;
-
-        std::string nodes = "std::vector<int> nodesInLayersCount = {";
-        for (auto nodesInLayer: nodesInLayersCount)
-            nodes += std::to_string(nodesInLayer) + ",";
-        if (!nodes.empty())
-            nodes = nodes.substr(0, nodes.size() - 1);
-        nodes += "};";
-        outputFile << nodes << std::endl;
-
-        double time = double(cmasols.elapsed_time()) / 1000.0;
-        outputFile << "double time = " << time << ";" << std::endl;
-
-        outputFile.close();
-    } else std::cout << "Couldn't open file " << filename << std::endl;
+    NetworkWeights result;
+    result.nodesInLayersCount = nodesInLayersCount;
+    result.weights = cmasols.best_candidate().get_x();
+    result.fvalue = cmasols.best_candidate().get_fvalue();
+    result.time = double(cmasols.elapsed_time()) / 1000.0;
+    try {
+        result.write(filename);
+    } catch (const std::runtime_error &e) {
+        std::cout << e.what() << std::endl;
+    }
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    std::string dataDir = argc > 1 ? argv[1] : "examples/data"; //best-solution corpus and weights
+    std::string traceDir = argc > 2 ? argv[2] : ""; //validation traces, none when empty
+
     int levelsAmount = 21;
     int firstLayer = 6 + levelsAmount + 1 + Palette::itemTypesNumberLimit +
                      4; //base + levels + 1 for used cps + itemTypes + additional params
@@ -122,53 +115,77 @@ int main() {
 
     int experimentsPerIteration = 50;
 
-    FitFunc fContainer = [&minLength, &maxLength, &minCount, &maxCount, &itemsTypeCount, &difficulty, &nodesInLayersCount, &levelsAmount, &experimentsPerIteration](
+    // common random numbers: candidates of a generation are rated on the same instances, drawn from the generation's seed
+    Generator generator(minLength, maxLength, minCount, maxCount, itemsTypeCount, difficulty);
+    std::mutex poolMtx;
+    uint64_t poolSeed = 0;
+    std::shared_ptr<const InstancePool> pool;
+
+    // generalization of the best candidate, measured on the corpus in the background every validationPeriod generations
+    InstanceCorpus corpus(dataDir + "/best-solution.corpus");
+    Validator validator(corpus, levelsAmount);
+    int validationPeriod = 10;
+    std::future<ValidationStats> validation;
+
+    // candidates stop packing once they cannot reach the mu-th best of the previous generation, minus a margin since
+    // that generation was rated on other instances
+    double cutoff = -std::numeric_limits<double>::infinity();
+    double cutoffMargin = 0.02;
+    ProgressFunc<CMAParameters<>, CMASolutions> progressFunc = [&](const CMAParameters<> &cmaparams,
+                                                                   const CMASolutions &cmasols) {
+        cutoff = -cmasols.get_candidate(cmaparams.lambda() / 2 - 1).get_fvalue() - cutoffMargin; //maximized, so negated
+
+        if (validation.valid() && validation.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            ValidationStats stats = validation.get();
+            std::cout << "Validation: mean " << stats.mean << ", median " << stats.median << ", deciles "
+                      << stats.lowerDecile << " " << stats.upperDecile << ", worst " << stats.worst << " ("
+                      << stats.worstInstance << ")" << std::endl;
+        }
+        if (cmasols.niter() % validationPeriod == 0 && !validation.valid())
+            validation = validator.validateAsync(
+                    NeuralNetwork(nodesInLayersCount, cmasols.best_candidate().get_x_ptr()));
+        return 0;
+    };
+
+    FitFunc fContainer = [&generator, &poolMtx, &poolSeed, &pool, &cutoff, &nodesInLayersCount, &levelsAmount, &experimentsPerIteration](
             const double *x, const int N) {
 
-        auto weights = getWeightsMatrix(nodesInLayersCount, x);
-        double mean = 0.0;
-        std::mutex mtx;
-        std::vector<std::thread> threads{};
-        for (int i = 0; i < experimentsPerIteration; ++i) {
-            std::thread thread(
-                    [&minLength, &maxLength, &minCount, &maxCount, &mean, &mtx, &itemsTypeCount, &difficulty, &weights, &levelsAmount]() {
-                        Generator generator(minLength, maxLength, minCount, maxCount, itemsTypeCount, difficulty);
-                        generator.generate();
-                        auto itemTypes = generator.getItems();
-                        auto paletteSize = generator.getPaletteSize();
-
-                        Palette palette(paletteSize.first, paletteSize.second, itemTypes, weights, levelsAmount);
-
-                        mtx.lock();
-                        mean += palette.performSimulation();
-                        mtx.unlock();
-                    });
-            threads.push_back(std::move(thread));
+        std::shared_ptr<const InstancePool> instances;
+        {
+            std::lock_guard<std::mutex> lock(poolMtx);
+            uint64_t seed = eval_context()._seed;
+            if (!pool || seed != poolSeed) { //first candidate of the generation builds its instances
+                pool = std::make_shared<const InstancePool>(generator, experimentsPerIteration, seed);
+                poolSeed = seed;
+            }
+            instances = pool;
         }
 
-        for (int i = 0; i < experimentsPerIteration; i++)
-            threads[i].join();
-
-        double feval = mean / double(experimentsPerIteration);
+        // candidates run in parallel, the network is specialized for the topology when it is a common one
+        MeanSimulation simulation{*instances, experimentsPerIteration, levelsAmount, cutoff};
+        auto result = visitNetwork(nodesInLayersCount, x, simulation);
+        double feval = result.second;
 
-        std::cout << "Feval: " << feval << std::endl;
+        std::cout << "Feval: " << feval << (result.first ? "" : " (stopped)") << std::endl;
         return feval;
     };
 //int lambda = 100; // offsprings at each generation.
     CMAParameters<> cmaparams(x0, sigma);
     cmaparams.set_mt_feval(true);
+    cmaparams.set_crn(true);
     cmaparams.set_maximize(true);
     cmaparams.set_ftarget(-0.94); //stupid, because it should be 0.9 in maximize
 
 //todo uncomment for learning
-//    CMASolutions cmasols = cmaes<>(fContainer, cmaparams);
+//    CMASolutions cmasols = cmaes<>(fContainer, cmaparams, progressFunc);
 //
-//    std::string outputFile = "bla3.h";
+//    std::string outputFile = "bla3.weights";
 //    print_result_to_file(cmasols, nodesInLayersCount, outputFile);
 //    return cmasols.run_status();
 
 
-    auto weights = getWeightsMatrix(nodesInLayersCount, &resultWeights[0]);
+    auto bestSolution = NetworkWeights::read(dataDir + "/best-solution.weights");
+    NeuralNetwork network(bestSolution.nodesInLayersCount, &bestSolution.weights[0]);
 //    std::list<ItemTypeTuple> items = {{{18, 15}, 11},
 //                                      {{19, 16}, 35},
 //                                      {{16, 15}, 23},
@@ -178,18 +195,9 @@ int main() {
 //    LengthUnit width = 11459;
 //    LengthUnit height = 11459;
 
-    for (int i = 1; i <= itemTypesVector.size(); i++) {
-        if (i == 12 || i == 18 || i == 24 || i == 27)
-            continue;
-        auto items = itemTypesVector[i];
-        LengthUnit width = paletteSizes[i].first;
-        LengthUnit height = paletteSizes[i].second;
-
-        Palette palette(width, height, items, weights, levelsAmount);
-        std::string file = "/home/deikare/wut/pbad-2d-bin-packing/data/data" + std::to_string(i) + ".txt";
-        auto result = palette.performSimulationWithSaveToFile(file);
-        std::cout << i << ") " << result << std::endl;
-    }
-
-
+    ValidationStats stats = validator.validate(network, traceDir);
+    for (size_t i = 0; i < stats.results.size(); i++)
+        std::cout << i << ") " << stats.results[i] << std::endl;
+    std::cout << "mean " << stats.mean << ", median " << stats.median << ", deciles " << stats.lowerDecile << " "
+              << stats.upperDecile << ", worst " << stats.worst << " (" << stats.worstInstance << ")" << std::endl;
 }
@@ -0,0 +1,198 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <gflags/gflags.h>
+#include "simulator/Palette.h"
+#include "simulator/Generator.h"
+#include "simulator/NetworkWeights.h"
+#include "simulator/InstanceCorpus.h"
+
+#ifndef GFLAGS_GFLAGS_H_
+namespace gflags = google;
+#endif  // GFLAGS_GFLAGS_H_
+
+DEFINE_string(data_dir, "examples/data", "directory holding best-solution.weights and best-solution.corpus");
+DEFINE_string(output, "", "file to write the JSON report to, stdout when empty");
+DEFINE_int32(instances, 50, "generated instances per size class, 0 benchmarks the corpus only");
+DEFINE_int32(max_threads, int(std::max(1u, std::thread::hardware_concurrency())), "largest thread count measured");
+DEFINE_int32(nn_calls, 200000, "forward passes timed for the network latency");
+DEFINE_uint64(seed, 1, "seed of the generated instances");
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(const Clock::time_point &start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static const char *sizeClassNames[] = {"easy", "medium", "hard"};
+
+// size class of a corpus instance, from its largest item side: the corpus instances were generated with item
+// lengths below 20, 100 and 1000
+static size_t corpusSizeClass(const InstanceView &instance) {
+    LengthUnit longest = 0;
+    for (auto &item: instance)
+        longest = std::max<LengthUnit>(longest, std::max(item.width, item.height));
+    return longest <= 20 ? 0 : longest <= 100 ? 1 : 2;
+}
+
+// instance generator settings of a size class, for the generated instances
+struct SizeClass {
+    int minLength;
+    int maxLength;
+    int minCount;
+    int maxCount;
+    int itemTypesCount;
+};
+
+static const SizeClass sizeClasses[] = {
+        {10, 50,   2, 20, 5},
+        {10, 50,   2, 50, Palette::itemTypesNumberLimit},
+        {10, 1000, 2, 50, Palette::itemTypesNumberLimit}
+};
+
+struct SimulationRun {
+    double seconds = 0.0;
+    unsigned long trials = 0;
+    double meanResult = 0.0;
+};
+
+// packs every instance of pool once, spread over threadsNumber threads, TInstances is e.g. an InstancePool or a
+// std::vector<Instance>
+template<class TInstances>
+static SimulationRun simulate(const TInstances &pool, const NeuralNetwork &network, unsigned levelsNumber,
+                              int threadsNumber) {
+    std::vector<double> results(pool.size());
+    std::vector<unsigned long> trials(pool.size());
+    std::atomic<size_t> nextInstance{0};
+    auto worker = [&]() {
+        for (size_t i = nextInstance++; i < pool.size(); i = nextInstance++) {
+            const Instance &instance = pool[i];
+            Palette palette(instance.paletteSize.first, instance.paletteSize.second, instance.items, network,
+                            levelsNumber);
+            results[i] = palette.performSimulation();
+            trials[i] = palette.getPrefilterStats().first;
+        }
+    };
+
+    SimulationRun run;
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadsNumber; t++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &thread: threads)
+        thread.join();
+    run.seconds = secondsSince(start);
+
+    for (size_t i = 0; i < pool.size(); i++) {
+        run.trials += trials[i];
+        run.meanResult += results[i] / double(pool.size());
+    }
+    return run;
+}
+
+int main(int argc, char *argv[]) {
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    unsigned levelsNumber = 21;
+    NetworkWeights weights = NetworkWeights::read(FLAGS_data_dir + "/best-solution.weights");
+    NeuralNetwork network(weights.nodesInLayersCount, weights.weights.data());
+
+    std::ostringstream json;
+    json << "{\n";
+
+    // network latency, over random inputs so that nothing is folded away
+    {
+        std::mt19937 engine(static_cast<uint32_t>(FLAGS_seed));
+        std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+        std::vector<std::vector<float>> inputs(64, std::vector<float>(size_t(network.getInputSize())));
+        for (auto &input: inputs)
+            for (auto &value: input)
+                value = distribution(engine);
+
+        float checksum = 0.0f;
+        auto start = Clock::now();
+        for (int call = 0; call < FLAGS_nn_calls; call++)
+            checksum += network.simulate(inputs[call % inputs.size()])[0];
+        double seconds = secondsSince(start);
+
+        json << "  \"nn_simulate\": {\"topology\": [";
+        for (size_t layer = 0; layer < weights.nodesInLayersCount.size(); layer++)
+            json << (layer ? ", " : "") << weights.nodesInLayersCount[layer];
+        json << "], \"calls\": " << FLAGS_nn_calls << ", \"ns_per_call\": " << seconds * 1e9 / FLAGS_nn_calls
+             << ", \"checksum\": " << checksum << "},\n";
+    }
+
+    // corpus instances grouped by size class, copied out of the corpus before timing
+    InstanceCorpus corpus(FLAGS_data_dir + "/best-solution.corpus");
+    std::vector<std::vector<Instance>> corpusClasses(3);
+    std::vector<Instance> corpusInstances;
+    for (size_t i = 0; i < corpus.size(); i++) {
+        Instance instance{corpus[i].getItems(), corpus[i].getPaletteSize()};
+        corpusClasses[corpusSizeClass(corpus[i])].push_back(instance);
+        corpusInstances.push_back(instance);
+    }
+
+    // single threaded simulations per size class, trials are the legal insertion trials collected
+    auto writeRuns = [&](const char *section, const std::vector<SimulationRun> &runs,
+                         const std::vector<size_t> &instancesNumbers) {
+        json << "  \"" << section << "\": [\n";
+        for (size_t c = 0; c < runs.size(); c++) {
+            const SimulationRun &run = runs[c];
+            json << "    {\"class\": \"" << sizeClassNames[c] << "\", \"instances\": " << instancesNumbers[c]
+                 << ", \"seconds\": " << run.seconds << ", \"instances_per_second\": "
+                 << double(instancesNumbers[c]) / run.seconds << ", \"trials_per_second\": "
+                 << double(run.trials) / run.seconds << ", \"mean_result\": " << run.meanResult << "}"
+                 << (c + 1 == runs.size() ? "\n" : ",\n");
+        }
+        json << "  ],\n";
+    };
+
+    std::vector<SimulationRun> runs;
+    std::vector<size_t> instancesNumbers;
+    for (const auto &instances: corpusClasses) {
+        runs.push_back(simulate(instances, network, levelsNumber, 1));
+        instancesNumbers.push_back(instances.size());
+    }
+    writeRuns("simulation", runs, instancesNumbers);
+
+    // the same on generated instances, more of them per class than the corpus holds
+    if (FLAGS_instances > 0) {
+        runs.clear();
+        instancesNumbers.clear();
+        for (const SizeClass &sizeClass: sizeClasses) {
+            InstancePool pool(Generator(sizeClass.minLength, sizeClass.maxLength, sizeClass.minCount,
+                                        sizeClass.maxCount, sizeClass.itemTypesCount, 1),
+                              size_t(FLAGS_instances), FLAGS_seed);
+            runs.push_back(simulate(pool, network, levelsNumber, 1));
+            instancesNumbers.push_back(pool.size());
+        }
+        writeRuns("generated_simulation", runs, instancesNumbers);
+    }
+
+    // thread scaling on the whole corpus, threads doubled up to max_threads
+    json << "  \"scaling\": [\n";
+    int maxThreads = std::max(1, FLAGS_max_threads);
+    for (int threadsNumber = 1;; threadsNumber = std::min(2 * threadsNumber, maxThreads)) {
+        SimulationRun run = simulate(corpusInstances, network, levelsNumber, threadsNumber);
+        bool last = threadsNumber == maxThreads;
+        json << "    {\"threads\": " << threadsNumber << ", \"instances_per_second\": "
+             << double(corpusInstances.size()) / run.seconds << "}" << (last ? "\n" : ",\n");
+        if (last)
+            break;
+    }
+    json << "  ]\n}\n";
+
+    if (FLAGS_output.empty())
+        std::cout << json.str();
+    else std::ofstream(FLAGS_output) << json.str();
+    return 0;
+}
@@ -0,0 +1,30 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#include <iostream>
+#include <fstream>
+#include "simulator/PlacementTrace.h"
+
+// converts a binary placement trace to the text format read by the plotting scripts
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <trace> [csv]" << std::endl;
+        return 1;
+    }
+
+    try {
+        if (argc > 2) {
+            std::ofstream csv(argv[2]);
+            if (!csv) {
+                std::cerr << "cannot write " << argv[2] << std::endl;
+                return 1;
+            }
+            convertPlacementTraceToCsv(argv[1], csv);
+        } else convertPlacementTraceToCsv(argv[1], std::cout);
+    } catch (const std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -24,6 +24,7 @@
 
 #include <libcmaes/ipopcmastrategy.h>
 #include <random>
+#include <array>
 
 namespace libcmaes
 {
@@ -92,6 +93,19 @@ namespace libcmaes
     void r1();
     void r2();
 
+    /**
+     * \brief writes the restart bookkeeping, regime and budgets included, into checkpoints.
+     * @param out checkpoint output
+     */
+    void put_restarts(CheckpointOut &out) const;
+
+    /**
+     * \brief reads what put_restarts() writes, leaving the strategy unchanged.
+     * @param in checkpoint input
+     * @return function that sets the restarts read, empty if the checkpoint is invalid
+     */
+    std::function<void()> get_restarts(CheckpointIn &in);
+
   private:
     std::mt19937 _gen;
     std::uniform_real_distribution<> _unif;
@@ -99,6 +113,8 @@ namespace libcmaes
     double _lambda_l;
     double _sigma_init; // to save the original value
     double _max_fevals; // to save the original value
+    std::array<int,2> _budgets = {{0,0}}; // 0: r1, 1: r2
+    int _regime = 0; // 0: r1, 1: r2
   };
 }
 
@@ -0,0 +1,377 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <libcmaes/eo_matrix.h>
+#include <libcmaes/candidate.h>
+#include <libcmaes/cmaes_export.h>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace libcmaes
+{
+  class CMASolutions;
+
+  /**
+   * \brief binary output of a checkpoint, in host byte order. Matrices are written
+   *        as their dimensions followed by their values, in column-major order.
+   */
+  class CheckpointOut
+  {
+  public:
+    CheckpointOut() {}
+    ~CheckpointOut() {}
+
+    void put(const bool &v) { char c = v; raw(&c,1); }
+    void put(const short &v) { raw(&v,sizeof(v)); }
+    void put(const int &v) { raw(&v,sizeof(v)); }
+    void put(const uint32_t &v) { raw(&v,sizeof(v)); }
+    void put(const uint64_t &v) { raw(&v,sizeof(v)); }
+    void put(const double &v) { raw(&v,sizeof(v)); }
+
+    void put(const std::string &s)
+    {
+      put(static_cast<uint64_t>(s.size()));
+      raw(s.data(),s.size());
+    }
+
+    void put(const dMat &m)
+    {
+      put(static_cast<uint64_t>(m.rows()));
+      put(static_cast<uint64_t>(m.cols()));
+      raw(m.data(),m.size()*sizeof(double));
+    }
+
+    void put(const dVec &v)
+    {
+      put(static_cast<uint64_t>(v.size()));
+      raw(v.data(),v.size()*sizeof(double));
+    }
+
+    void put(const std::vector<double> &v)
+    {
+      put(static_cast<uint64_t>(v.size()));
+      raw(v.data(),v.size()*sizeof(double));
+    }
+
+    void put(const std::vector<uint64_t> &v)
+    {
+      put(static_cast<uint64_t>(v.size()));
+      raw(v.data(),v.size()*sizeof(uint64_t));
+    }
+
+    void put(const Candidate &c)
+    {
+      put(c.get_fvalue());
+      put(c.get_x_dvec());
+      put(c.get_id());
+      put(c.get_rank());
+    }
+
+    void put(const std::vector<Candidate> &v)
+    {
+      put(static_cast<uint64_t>(v.size()));
+      for (const Candidate &c : v)
+	put(c);
+    }
+
+    void raw(const void *data, const size_t &size)
+    {
+      const char *bytes = static_cast<const char*>(data);
+      _buf.insert(_buf.end(),bytes,bytes+size);
+    }
+
+    std::vector<char> _buf;
+  };
+
+  /**
+   * \brief binary input of a checkpoint, see CheckpointOut. Reading past the end or
+   *        a size that does not fit the remaining bytes turns good() off for good.
+   */
+  class CheckpointIn
+  {
+  public:
+    CheckpointIn(const std::vector<char> &buf)
+      :_p(buf.data()),_end(buf.data()+buf.size())
+    {
+    }
+
+    ~CheckpointIn() {}
+
+    inline bool good() const { return _good; }
+
+    void get(bool &v) { char c = 0; raw(&c,1); v = c != 0; }
+    void get(short &v) { raw(&v,sizeof(v)); }
+    void get(int &v) { raw(&v,sizeof(v)); }
+    void get(uint32_t &v) { raw(&v,sizeof(v)); }
+    void get(uint64_t &v) { raw(&v,sizeof(v)); }
+    void get(double &v) { raw(&v,sizeof(v)); }
+
+    void get(std::string &s)
+    {
+      uint64_t n = size(1);
+      s.assign(_good ? _p : "",n);
+      skip(n);
+    }
+
+    void get(dMat &m)
+    {
+      uint64_t rows = 0, cols = 0;
+      get(rows);
+      get(cols);
+      if (!_good || (rows && cols > remaining() / sizeof(double) / rows))
+	{
+	  _good = false;
+	  return;
+	}
+      m.resize(rows,cols);
+      raw(m.data(),m.size()*sizeof(double));
+    }
+
+    void get(dVec &v)
+    {
+      v.resize(size(sizeof(double)));
+      raw(v.data(),v.size()*sizeof(double));
+    }
+
+    void get(std::vector<double> &v)
+    {
+      v.resize(size(sizeof(double)));
+      raw(v.data(),v.size()*sizeof(double));
+    }
+
+    void get(std::vector<uint64_t> &v)
+    {
+      v.resize(size(sizeof(uint64_t)));
+      raw(v.data(),v.size()*sizeof(uint64_t));
+    }
+
+    void get(Candidate &c)
+    {
+      double fvalue = 0.0;
+      int id = -1, rank = -1;
+      get(fvalue);
+      get(c.get_x_dvec_ref());
+      get(id);
+      get(rank);
+      c.set_fvalue(fvalue);
+      c.set_id(id);
+      c.set_rank(rank);
+    }
+
+    void get(std::vector<Candidate> &v)
+    {
+      v.resize(size(1));
+      for (Candidate &c : v)
+	get(c);
+    }
+
+    void raw(void *data, const size_t &n)
+    {
+      if (!_good || n > remaining())
+	{
+	  _good = false;
+	  return;
+	}
+      std::memcpy(data,_p,n);
+      _p += n;
+    }
+
+  private:
+    inline size_t remaining() const { return static_cast<size_t>(_end-_p); }
+
+    // reads a number of elements, 0 when they cannot fit the remaining bytes.
+    uint64_t size(const size_t &element)
+    {
+      uint64_t n = 0;
+      get(n);
+      if (_good && n > remaining() / element)
+	_good = false;
+      return _good ? n : 0;
+    }
+
+    void skip(const size_t &n)
+    {
+      if (_good)
+	_p += n;
+    }
+
+    const char *_p;
+    const char *_end;
+    bool _good = true;
+  };
+
+  /**
+   * \brief versioned checkpoints of the search state, see Parameters::set_checkpoint().
+   *        A checkpoint starts with the magic "LCMAESCK", a version, the problem
+   *        dimension and the seed, followed by the state of the strategy and of
+   *        its solutions.
+   */
+  class CMAES_EXPORT Checkpoint
+  {
+  public:
+    static const uint32_t _version = 1;
+
+    /**
+     * \brief writes the header of a checkpoint.
+     */
+    static void put_header(CheckpointOut &out, const int &dim, const uint64_t &seed);
+
+    /**
+     * \brief reads and checks the header of a checkpoint.
+     * @return false when the magic, the version or the dimension do not match
+     */
+    static bool get_header(CheckpointIn &in, const int &dim, uint64_t &seed);
+
+    /**
+     * \brief writes the search state held by solutions. Profile likelihoods, the
+     *        expected distance to the minimum and the phase timers are not part of it.
+     */
+    static void put(CheckpointOut &out, const CMASolutions &sols);
+
+    /**
+     * \brief reads the search state written by put() into solutions.
+     */
+    static void get(CheckpointIn &in, CMASolutions &sols);
+
+    /**
+     * \brief reads a whole checkpoint file.
+     * @return false if the file cannot be read
+     */
+    static bool read_file(const std::string &filename, std::vector<char> &buf);
+  };
+
+  /**
+   * \brief writes checkpoints from a background thread, so that the optimization only
+   *        pays for copying its state. Every checkpoint replaces the previous one
+   *        through a temporary file, so that a crash leaves the last complete one.
+   *        When checkpoints come faster than they are written, the most recent
+   *        one waiting replaces the others.
+   */
+  class CheckpointWriter
+  {
+  public:
+    CheckpointWriter(const std::string &filename)
+      :_filename(filename)
+    {
+      _writer = std::thread(&CheckpointWriter::run,this);
+    }
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    ~CheckpointWriter()
+    {
+      {
+	std::lock_guard<std::mutex> lock(_mtx);
+	_stopping = true;
+      }
+      _changed.notify_all();
+      _writer.join();
+    }
+
+    /**
+     * \brief hands a checkpoint over to the writer thread.
+     * @param buf checkpoint, swapped with an unused buffer
+     */
+    void submit(std::vector<char> &buf)
+    {
+      {
+	std::lock_guard<std::mutex> lock(_mtx);
+	std::swap(_pending,buf);
+	_has_pending = true;
+      }
+      _changed.notify_all();
+    }
+
+    /**
+     * \brief waits until every submitted checkpoint is written.
+     * @return false if the last write failed
+     */
+    bool flush()
+    {
+      std::unique_lock<std::mutex> lock(_mtx);
+      _changed.wait(lock,[this]{ return !_has_pending && !_busy; });
+      return _ok;
+    }
+
+  private:
+    void run()
+    {
+      std::vector<char> buf;
+      std::unique_lock<std::mutex> lock(_mtx);
+      while(true)
+	{
+	  _changed.wait(lock,[this]{ return _stopping || _has_pending; });
+	  if (!_has_pending) // stopping.
+	    break;
+	  std::swap(_pending,buf);
+	  _has_pending = false;
+	  _busy = true;
+	  lock.unlock();
+	  bool ok = write(buf);
+	  lock.lock();
+	  _busy = false;
+	  _ok = ok;
+	  _changed.notify_all();
+	}
+    }
+
+    bool write(const std::vector<char> &buf) const
+    {
+      std::string tmp = _filename + ".tmp";
+      {
+	std::ofstream out(tmp,std::ios::binary);
+	out.write(buf.data(),buf.size());
+	if (!out)
+	  return false;
+      }
+      if (std::rename(tmp.c_str(),_filename.c_str()) != 0)
+	{
+	  std::remove(_filename.c_str()); // rename does not replace files on some systems.
+	  return std::rename(tmp.c_str(),_filename.c_str()) == 0;
+	}
+      return true;
+    }
+
+    std::string _filename;
+    std::vector<char> _pending; /**< last submitted checkpoint, when _has_pending. */
+    bool _has_pending = false;
+    bool _busy = false; /**< whether a checkpoint is being written. */
+    bool _ok = true; /**< whether the last write succeeded. */
+    bool _stopping = false;
+    std::mutex _mtx;
+    std::condition_variable _changed;
+    std::thread _writer;
+  };
+}
+
+#endif
@@ -219,6 +219,77 @@ namespace libcmaes
        */
       inline int get_restarts() const { return _nrestarts; }
 
+      /**
+       * \brief sets the number of restarts that are run concurrently, as independent
+       *        islands (applies to IPOP and BIPOP). Islands share the budget of function
+       *        evaluations and the best solution found so far. With BIPOP, one large
+       *        population restart runs at a time, and once one has completed, the budget
+       *        of small population restarts is split among the other islands.
+       * @param n number of islands, 1 runs restarts one after another
+       */
+      inline void set_islands(const int &n) { _nislands = n; }
+
+      /**
+       * \brief get the number of concurrent restarts (applies to IPOP and BIPOP).
+       * @return number of islands
+       */
+      inline int get_islands() const { return _nislands; }
+
+      /**
+       * \brief activates migration of the best solution found so far by any island
+       *        into the population of the other islands.
+       * @param b whether to activate migration
+       */
+      inline void set_islands_migration(const bool &b) { _islands_migration = b; }
+
+      /**
+       * \brief get island migration status.
+       * @return whether migration is activated
+       */
+      inline bool get_islands_migration() const { return _islands_migration; }
+
+      /**
+       * \brief activates warm restarts (applies to IPOP and BIPOP): a restart keeps the
+       *        shape of the previous run's covariance matrix, rescaled to unit mean eigenvalue,
+       *        instead of relearning it from the identity. Island restarts start from
+       *        the best run completed so far by any island.
+       * @param b whether to activate warm restarts
+       */
+      inline void set_warm_restarts(const bool &b) { _warm_restarts = b; }
+
+      /**
+       * \brief get warm restarts status.
+       * @return whether warm restarts are activated
+       */
+      inline bool get_warm_restarts() const { return _warm_restarts; }
+
+      /**
+       * \brief sets the exponent applied to the eigenvalues of the inherited covariance matrix
+       *        on warm restarts: 1 keeps a scaled copy of the matrix, 0 keeps its eigenbasis only
+       *        (i.e. a cold restart), values in between damp the learned conditioning.
+       * @param e exponent, in [0,1]
+       */
+      inline void set_warm_restarts_cexp(const double &e) { _warm_cexp = e; }
+
+      /**
+       * \brief get the exponent applied to the inherited eigenvalues on warm restarts.
+       * @return eigenvalue exponent
+       */
+      inline double get_warm_restarts_cexp() const { return _warm_cexp; }
+
+      /**
+       * \brief sets the initial mean of warm restarts as a mix of the best point found by
+       *        the previous run and of a fresh initial point (x0 or a random point within bounds).
+       * @param m weight of the best point, in [0,1]
+       */
+      inline void set_warm_restarts_mix(const double &m) { _warm_mix = m; }
+
+      /**
+       * \brief get the weight of the previous best point in the initial mean of warm restarts.
+       * @return weight of the best point
+       */
+      inline double get_warm_restarts_mix() const { return _warm_mix; }
+
       /**
        * \brief sets the lazy update (i.e. updates the eigenvalues every few steps).
        * @param lz whether to activate the lazy update
@@ -304,6 +375,11 @@ namespace libcmaes
       double _sigma_init; /**< initial sigma value. */
       
       int _nrestarts = 9; /**< maximum number of restart, when applicable. */
+      int _nislands = 1; /**< number of restarts run concurrently, when applicable. */
+      bool _islands_migration = false; /**< whether islands receive the best solution found so far. */
+      bool _warm_restarts = false; /**< whether restarts inherit the previous covariance matrix. */
+      double _warm_cexp = 1.0; /**< exponent applied to the inherited eigenvalues. */
+      double _warm_mix = 0.0; /**< weight of the previous best point in the restart mean. */
       bool _lazy_update; /**< covariance lazy update. */
       double _lazy_value; /**< reference trigger for lazy update. */
       
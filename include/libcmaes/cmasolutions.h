@@ -28,6 +28,7 @@
 #include <libcmaes/cmaparameters.h>
 #include <libcmaes/cmastopcriteria.h>
 #include <libcmaes/pli.h>
+#include <libcmaes/phasetimers.h>
 #include <vector>
 #include <algorithm>
 
@@ -50,10 +51,12 @@ namespace libcmaes
     friend class ACovarianceUpdate;
     template <class U> friend class errstats;
 #ifdef HAVE_SURROG
+    template <template <class X,class Y> class U, class V, class W> friend class SurrogateStrategy;
     template <template <class X,class Y> class U, class V, class W> friend class SimpleSurrogateStrategy;
     template <template <class X,class Y> class U, class V, class W> friend class ACMSurrogateStrategy;
 #endif
     friend class VDCMAUpdate;
+    friend class Checkpoint;
     
   public:
     /**
@@ -401,6 +404,35 @@ namespace libcmaes
       return _elapsed_last_iter;
     }
     
+    /**
+     * \brief returns the timing statistics of a phase of the optimization steps,
+     *        cumulated since the solutions were initialized, see Parameters::set_phase_timing().
+     * @param p phase, e.g. PHASE_EVAL
+     * @return timing statistics, in nanoseconds
+     */
+    inline const PhaseStats& phase_stats(const int &p) const
+    {
+      return _timers.stats(p);
+    }
+
+    /**
+     * \brief returns whether phases of the optimization steps are being timed
+     * @return timing status
+     */
+    inline bool phase_timing() const
+    {
+      return _timers.enabled();
+    }
+
+    /**
+     * \brief turns the timing of phases on or off during the run, e.g. from a progress function
+     * @param t true to time phases, false otherwise
+     */
+    inline void set_phase_timing(const bool &t)
+    {
+      _timers.set_enabled(t);
+    }
+    
     /**
      * \brief returns current number of iterations
      * @return number of iterations
@@ -419,6 +451,25 @@ namespace libcmaes
       return _nevals;
     }
     
+    /**
+     * \brief returns the number of objective function values found in cache
+     * @return number of cache hits
+     */
+    inline int cache_hits() const
+    {
+      return _cache_hits;
+    }
+
+    /**
+     * \brief returns the number of objective function values not found in cache,
+     *        i.e. of actual objective function calls while the cache is active
+     * @return number of cache misses
+     */
+    inline int cache_misses() const
+    {
+      return _cache_misses;
+    }
+    
     /**
      * \brief returns current minimal eigen value
      * @return minimal eigen value
@@ -503,6 +554,8 @@ namespace libcmaes
     dMat _leigenvectors; /**< last computed eigenvectors, for termination criteria. */
     int _niter = 0; /**< number of iterations to reach this solution, for termination criteria. */
     int _nevals = 0; /**< number of function calls to reach the current solution. */
+    int _cache_hits = 0; /**< number of objective function values found in cache. */
+    int _cache_misses = 0; /**< number of objective function values not found in cache. */
     int _kcand = 1;
     std::vector<Candidate> _k_best_candidates_hist; /**< k-th best candidate history, for termination criteria, k is kcand=1+floor(0.1+lambda/4). */
     std::vector<double> _bfvalues; /**< best function values over the past 20 steps, for termination criteria. */
@@ -515,12 +568,7 @@ namespace libcmaes
     int _run_status = 0; /**< current status of the stochastic optimization (e.g. running, or stopped under termination criteria). */
     int _elapsed_time = 0; /**< final elapsed time of stochastic optimization. */
     int _elapsed_last_iter = 0; /**< time consumed during last iteration. */
-#ifdef HAVE_DEBUG
-    int _elapsed_eval = 0;
-    int _elapsed_ask = 0;
-    int _elapsed_tell = 0;
-    int _elapsed_stop = 0;
-#endif
+    PhaseTimers _timers; /**< per-phase timing statistics. */
 
     std::map<int,pli> _pls; /**< profile likelihood for parameters it has been computed for. */
     double _edm = 0.0; /**< expected vertical distance to the minimum. */
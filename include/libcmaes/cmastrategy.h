@@ -30,6 +30,8 @@
 #include <libcmaes/acovarianceupdate.h>
 #include <libcmaes/vdcmaupdate.h>
 #include <libcmaes/eigenmvn.h>
+#include <libcmaes/fplotwriter.h>
+#include <libcmaes/checkpoint.h>
 #include <fstream>
 
 namespace libcmaes
@@ -119,11 +121,32 @@ namespace libcmaes
        *        as defined in the _parameters object.
        */
       void plot();
+
+      /**
+       * \brief Copies the search state, random generators included, and hands it over
+       *        to the background writer of the checkpoint file defined in the _parameters object.
+       *        Called every get_checkpoint_every() iterations by optimize().
+       */
+      void checkpoint();
+
+      /**
+       * \brief Restores the search state from a checkpoint file, so that optimize()
+       *        continues the run that wrote it. Must be called on the thread that runs
+       *        optimize(), before it. On failure, the search state is left unchanged.
+       * @param filename checkpoint file
+       * @return 0 on success, OPTI_ERR_CHECKPOINT otherwise
+       */
+      int resume(const std::string &filename);
     
     protected:
       Eigen::EigenMultivariateNormal<double> _esolver;  /**< multivariate normal distribution sampler, and eigendecomposition solver. */
       CMAStopCriteria<TGenoPheno> _stopcriteria; /**< holds the set of termination criteria, see reference paper. */
       std::ofstream *_fplotstream = nullptr; /**< plotting file stream, not in parameters because of copy-constructor hell. */
+      FPlotWriter *_fplotwriter = nullptr; /**< binary plotting file writer, replaces the stream when the output is binary. */
+      CheckpointWriter *_checkpointwriter = nullptr; /**< checkpoint file writer, when activated. */
+      bool _resumed = false; /**< whether the state comes from a checkpoint, until optimize() starts. */
+      std::function<void(CheckpointOut&)> _put_restarts; /**< writes the bookkeeping of restart strategies into checkpoints, when set. */
+      std::function<std::function<void()>(CheckpointIn&)> _get_restarts; /**< reads what _put_restarts writes, returns the function that sets it, empty if invalid. */
     
     public:
     static ProgressFunc<CMAParameters<TGenoPheno>,CMASolutions> _defaultPFunc; /**< the default progress function. */
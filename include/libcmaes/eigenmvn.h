@@ -35,7 +35,10 @@
 
 #include <Eigen/Dense>
 #include <random>
+#include <memory>
 #include <stdexcept>
+#include <sstream>
+#include <string>
 
 /*
   We need a functor that can pretend it's const,
@@ -55,10 +58,17 @@ private:
       std::swap(norm, other.norm);
     }
 public:
-	static std::mt19937 rng;                        // The uniform pseudo-random algorithm
+	std::shared_ptr<std::mt19937> rng;             // The uniform pseudo-random algorithm, owned by the sampler so that its seed holds on any thread
 	mutable std::normal_distribution<Scalar> norm; // gaussian combinator
 	
-	EIGEN_EMPTY_STRUCT_CTOR(scalar_normal_dist_op)
+	scalar_normal_dist_op():rng(std::make_shared<std::mt19937>()) {}
+	scalar_normal_dist_op(const scalar_normal_dist_op &other):rng(other.rng) {} // copies share the generator, not the gaussian state
+    
+    scalar_normal_dist_op &operator=(const scalar_normal_dist_op &other)
+    {
+        rng = other.rng;
+        return *this;
+    }
     
     scalar_normal_dist_op &operator=(scalar_normal_dist_op &&other) 
     {
@@ -73,13 +83,29 @@ public:
     }
 
 	template<typename Index>
-	inline const Scalar operator() (Index, Index = 0) const { return norm(rng); }
-	inline void seed(const uint64_t &s) { rng.seed(s); }
+	inline const Scalar operator() (Index, Index = 0) const { return norm(*rng); }
+	inline void seed(const uint64_t &s) { rng = std::make_shared<std::mt19937>(s); } // a new generator, copies keep drawing from the former one
+	// state of the generator and of the gaussian combinator, as text from the standard library.
+	std::string state() const
+	{
+	  std::ostringstream out;
+	  out << *rng << ' ' << norm;
+	  return out.str();
+	}
+	bool set_state(const std::string &s) // unchanged when s is not a state.
+	{
+	  std::mt19937 r;
+	  std::normal_distribution<Scalar> n;
+	  std::istringstream in(s);
+	  in >> r >> n;
+	  if (in.fail())
+	    return false;
+	  *rng = r;
+	  norm = n;
+	  return true;
+	}
       };
 
-    template<typename Scalar>
-      std::mt19937 scalar_normal_dist_op<Scalar>::rng;
-      
     template<typename Scalar>
       struct functor_traits<scalar_normal_dist_op<Scalar> >
       { enum { Cost = 50 * NumTraits<Scalar>::MulCost, PacketAccess = false, IsRepeatable = false }; };
@@ -124,6 +150,24 @@ public:
       setCovar(covar);
     }
 
+    /**
+     * \brief draws from a new generator seeded with s, e.g. a seed-derived stream.
+     *        Copies of this object share the generator.
+     */
+    void set_stream(const uint64_t &s) { randN.seed(s); }
+
+    /**
+     * \brief state of the generator, for checkpoints.
+     */
+    std::string rng_state() const { return randN.state(); }
+    bool set_rng_state(const std::string &s) { return randN.set_state(s); }
+
+    /**
+     * \brief mean and covariance of the last setMean and setCovar calls.
+     */
+    const Matrix<Scalar,Dynamic,1>& mean() const { return _mean; }
+    const Matrix<Scalar,Dynamic,Dynamic>& covar() const { return _covar; }
+
     void setMean(const Matrix<Scalar,Dynamic,1>& mean) { _mean = mean; }
     void setCovar(const Matrix<Scalar,Dynamic,Dynamic>& covar)
     {
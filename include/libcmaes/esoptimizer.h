@@ -24,9 +24,13 @@
 
 #include <functional>
 #include <chrono>
+#include <fstream>
+#include <string>
 #include <libcmaes/parameters.h>
 #include <libcmaes/esostrategy.h>
 #include <libcmaes/cmasolutions.h>
+#include <libcmaes/opti_err.h>
+#include <libcmaes/llogging.h>
 
 /* algorithms */
 enum {
@@ -111,10 +115,23 @@ namespace libcmaes
        */
       int optimize()
       {
+	// continues from the checkpoint file when asked to and when there is one.
+	const std::string checkpoint = TESOStrategy::_parameters.get_checkpoint_file();
+	if (TESOStrategy::_parameters.get_resume() && !checkpoint.empty() && std::ifstream(checkpoint).good())
+	  {
+	    int rerr = TESOStrategy::resume(checkpoint);
+	    if (rerr != OPTI_SUCCESS)
+	      {
+		TESOStrategy::_solutions._run_status = rerr; // so that callers of cmaes() see it.
+		return rerr;
+	      }
+	  }
 	std::chrono::time_point<std::chrono::system_clock> tstart = std::chrono::system_clock::now();
 	int opt = TESOStrategy::optimize();
 	std::chrono::time_point<std::chrono::system_clock> tstop = std::chrono::system_clock::now();
 	TESOStrategy::_solutions._elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(tstop-tstart).count();
+	if (TESOStrategy::_tracer && !TESOStrategy::_tracer->write(TESOStrategy::_parameters.get_trace_file()))
+	  LOG(ERROR) << "cannot write trace file " << TESOStrategy::_parameters.get_trace_file() << std::endl;
 	return opt;
       }
     };
@@ -25,7 +25,11 @@
 #include <libcmaes/eo_matrix.h> // to include Eigen everywhere.
 #include <libcmaes/candidate.h>
 #include <libcmaes/eigenmvn.h>
+#include <libcmaes/evalcache.h>
+#include <libcmaes/tracer.h>
+#include <libcmaes/checkpoint.h>
 #include <random>
+#include <memory>
 
 namespace libcmaes
 {
@@ -36,6 +40,29 @@ namespace libcmaes
   typedef std::function<dMat(void)> AskFunc;
   typedef std::function<void(void)> TellFunc;
   
+  /**
+   * \brief context of the objective function calls of a generation. With common random numbers
+   *        activated (see Parameters::set_crn), all candidates of a generation see the same seed.
+   */
+  struct EvalContext
+  {
+    uint64_t _seed = 0; /**< seed for the random draws of the objective function, 0 without common random numbers. */
+    int _generation = -1; /**< generation count since the strategy was built, -1 outside of an optimization. */
+    Tracer *_tracer = nullptr; /**< timeline of the optimization, for the objective function to record its own spans, null when deactivated. */
+  };
+
+  /**
+   * \brief returns the context of the objective function call running on the calling thread.
+   * @return evaluation context
+   */
+  CMAES_EXPORT const EvalContext& eval_context();
+
+  /**
+   * \brief sets the evaluation context of the calling thread, for custom evaluation loops.
+   * @param context evaluation context
+   */
+  CMAES_EXPORT void set_eval_context(const EvalContext &context);
+  
   template<class TParameters,class TSolutions>
     using ProgressFunc = std::function<int (const TParameters&, const TSolutions&)>; // template aliasing.
 
@@ -224,6 +251,7 @@ namespace libcmaes
 
 		/**
 		 * \brief part of the ucertainty handling scheme that evaluate the candidates to be reevaluated.
+		 *        Evaluations are parallel when _mt_feval is set, as in eval().
 		 */
 		void eval_candidates_uh(const dMat& candidates, const dMat& candidates_uh, std::vector<RankedCandidate>& nvcandidates, int& nfcalls);
 
@@ -243,8 +271,68 @@ namespace libcmaes
     Candidate best_solution() const;
 
     void set_initial_elitist(const bool &e) { _initial_elitist = e; }
+
+    /**
+     * \brief returns the timeline recorder, null unless Parameters::set_trace_file() was called.
+     * @return tracer
+     */
+    std::shared_ptr<Tracer> get_tracer() const { return _tracer; }
+
+    /**
+     * \brief records the timeline into an existing tracer, e.g. the one of an enclosing optimizer.
+     * @param tracer tracer, null to deactivate
+     */
+    void set_tracer(const std::shared_ptr<Tracer> &tracer)
+    {
+      _tracer = tracer;
+      _eval_context._tracer = tracer.get();
+    }
     
   protected:
+    /**
+     * \brief calls the objective function, through the evaluation cache when active.
+     * @param x point in phenotype space
+     * @param N dimension of x
+     * @param hit whether the value was found in cache, in which case no function call counts against the budget
+     * @return objective function value
+     */
+    double fcall(const double *x, const int &N, bool &hit);
+
+    /**
+     * \brief calls the objective function within the current generation's evaluation context,
+     *        bypassing the cache.
+     * @param x point in phenotype space
+     * @param N dimension of x
+     * @return objective function value
+     */
+    double func_call(const double *x, const int &N);
+
+    /**
+     * \brief moves the evaluation context to the next generation.
+     */
+    void next_eval_context();
+
+    /**
+     * \brief accounts for a single call to fcall(), in the budget and in the cache statistics.
+     * @param hit whether the value was found in cache
+     */
+    void update_fevals_cached(const bool &hit);
+
+    /**
+     * \brief writes the counters, evaluation context, cache and uncertainty handling
+     *        generators of the strategy, for checkpoints.
+     * @param out checkpoint output
+     */
+    void put_state(CheckpointOut &out) const;
+
+    /**
+     * \brief reads what put_state() writes, leaving the strategy unchanged.
+     * @param in checkpoint input
+     * @return function that sets the state read, empty if the checkpoint does not match the strategy, e.g. the cache size
+     */
+    std::function<void()> get_state(CheckpointIn &in);
+    
+
     FitFunc _func; /**< the objective function. */
     int _nevals;  /**< number of function evaluations. */
     int _niter;  /**< number of iterations. */
@@ -255,6 +343,9 @@ namespace libcmaes
     PlotFunc<TParameters,TSolutions> _pffunc; /**< possibly custom stream data to file function. */
     FitFunc _funcaux;
     bool _initial_elitist = false; /**< restarts from and re-injects best seen solution if not the final one. */
+    std::shared_ptr<EvalCache> _evalcache; /**< cache of objective function values, when activated. */
+    EvalContext _eval_context; /**< evaluation context of the current generation. */
+    std::shared_ptr<Tracer> _tracer; /**< timeline recorder, when activated. */
 
   private:
     std::mt19937 _uhgen; /**< random device used for uncertainty handling operations. */
@@ -0,0 +1,236 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVALCACHE_H
+#define EVALCACHE_H
+
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+namespace libcmaes
+{
+  /**
+   * \brief size-bounded, lock-free cache of objective function values, keyed on
+   *        a hash of the quantized phenotype. The table is direct-mapped, a new
+   *        entry replaces the previous one in its slot. The objective function
+   *        is assumed deterministic.
+   */
+  class EvalCache
+  {
+  public:
+    /**
+     * \brief constructor.
+     * @param size number of entries, rounded up to a power of two, 0 deactivates the cache
+     * @param quantum size of the grid on which points are quantized before hashing, 0 uses exact values
+     */
+    EvalCache(const int &size, const double &quantum=0.0)
+      :_quantum(quantum)
+    {
+      if (size <= 0)
+	return;
+      while (_mask + 1 < static_cast<uint64_t>(size))
+	_mask = (_mask << 1) | 1;
+      _slots.reset(new Slot[_mask+1]);
+      for (uint64_t i=0;i<=_mask;i++)
+	{
+	  _slots[i]._seq = 0;
+	  _slots[i]._key = 0;
+	  _slots[i]._fvalue = 0;
+	}
+    }
+
+    ~EvalCache() {}
+
+    /**
+     * \brief returns the cached value of func at x, or calls func and caches its value.
+     * @param func objective function
+     * @param x point in phenotype space
+     * @param N dimension of x
+     * @param hit whether the value was found in cache
+     * @param salt mixed into the key, e.g. the seed of a stochastic objective function
+     * @return objective function value
+     */
+    template<class TFunc>
+      double eval(const TFunc &func, const double *x, const int &N, bool &hit, const uint64_t &salt=0)
+      {
+	uint64_t k = key(x,N,salt);
+	double fvalue;
+	if ((hit = get(k,fvalue)))
+	  {
+	    ++_hits;
+	    return fvalue;
+	  }
+	fvalue = func(x,N);
+	put(k,fvalue);
+	++_misses;
+	return fvalue;
+      }
+
+    /**
+     * \brief hashes a point, after quantization.
+     * @param x point in phenotype space
+     * @param N dimension of x
+     * @param salt mixed into the key
+     * @return non zero key
+     */
+    uint64_t key(const double *x, const int &N, const uint64_t &salt=0) const
+    {
+      uint64_t h = static_cast<uint64_t>(N) ^ mix(salt);
+      for (int i=0;i<N;i++)
+	{
+	  double v = _quantum > 0.0 ? std::floor(x[i]/_quantum + 0.5) : x[i]; // the rounded double is hashed, it may not fit an integer.
+	  if (v == 0.0) // -0.0 and 0.0 share their key.
+	    v = 0.0;
+	  uint64_t b;
+	  std::memcpy(&b,&v,sizeof(b));
+	  h = mix(h ^ mix(b + i));
+	}
+      return h ? h : 1;
+    }
+
+    /**
+     * \brief looks up a key.
+     * @param k key
+     * @param fvalue cached value, if any
+     * @return whether the key is in cache
+     */
+    bool get(const uint64_t &k, double &fvalue) const
+    {
+      if (!_slots)
+	return false;
+      const Slot &s = _slots[k & _mask];
+      uint64_t seq = s._seq.load();
+      if (seq & 1) // being written.
+	return false;
+      uint64_t b = s._fvalue.load();
+      if (s._key.load() != k || s._seq.load() != seq) // other key, or concurrently replaced.
+	return false;
+      std::memcpy(&fvalue,&b,sizeof(b));
+      return true;
+    }
+
+    /**
+     * \brief stores a value, replacing the slot's previous entry. The value is dropped
+     *        when another thread is writing to the same slot.
+     * @param k key
+     * @param fvalue objective function value
+     */
+    void put(const uint64_t &k, const double &fvalue)
+    {
+      if (!_slots)
+	return;
+      Slot &s = _slots[k & _mask];
+      uint64_t seq = s._seq.load();
+      if ((seq & 1) || !s._seq.compare_exchange_strong(seq,seq+1))
+	return;
+      uint64_t b;
+      std::memcpy(&b,&fvalue,sizeof(b));
+      s._key.store(k);
+      s._fvalue.store(b);
+      s._seq.store(seq+2);
+    }
+
+    /**
+     * \brief whether the cache holds any slot.
+     */
+    inline bool active() const { return _slots != nullptr; }
+
+    /**
+     * \brief number of cache hits since creation.
+     */
+    inline int hits() const { return _hits; }
+
+    /**
+     * \brief number of cache misses since creation.
+     */
+    inline int misses() const { return _misses; }
+
+    /**
+     * \brief copies the keys and values of all slots, then hits and misses, e.g. for
+     *        checkpoints. No thread may write to the cache meanwhile.
+     * @param state output, two values per slot
+     */
+    void save(std::vector<uint64_t> &state) const
+    {
+      state.clear();
+      if (_slots)
+	for (uint64_t i=0;i<=_mask;i++)
+	  {
+	    state.push_back(_slots[i]._key.load());
+	    state.push_back(_slots[i]._fvalue.load());
+	  }
+      state.push_back(static_cast<uint64_t>(_hits.load()));
+      state.push_back(static_cast<uint64_t>(_misses.load()));
+    }
+
+    /**
+     * \brief number of values written by save().
+     */
+    inline size_t state_size() const { return 2*(_slots ? _mask+1 : 0)+2; }
+
+    /**
+     * \brief restores slots, hits and misses from save(), on a cache of the same size.
+     * @param state input
+     * @return false if the state comes from a cache of another size
+     */
+    bool load(const std::vector<uint64_t> &state)
+    {
+      uint64_t nslots = _slots ? _mask+1 : 0;
+      if (state.size() != state_size())
+	return false;
+      for (uint64_t i=0;i<nslots;i++)
+	{
+	  _slots[i]._key.store(state[2*i]);
+	  _slots[i]._fvalue.store(state[2*i+1]);
+	}
+      _hits.store(static_cast<int>(state[2*nslots]));
+      _misses.store(static_cast<int>(state[2*nslots+1]));
+      return true;
+    }
+
+  private:
+    static inline uint64_t mix(uint64_t z)
+    {
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL; // splitmix64 finalizer.
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    struct Slot
+    {
+      std::atomic<uint64_t> _seq; /**< odd while the slot is being written. */
+      std::atomic<uint64_t> _key;
+      std::atomic<uint64_t> _fvalue;
+    };
+
+    double _quantum = 0.0; /**< quantization step, 0 for exact keys. */
+    uint64_t _mask = 0; /**< number of slots minus one. */
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<int> _hits{0};
+    std::atomic<int> _misses{0};
+  };
+}
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FPLOTWRITER_H
+#define FPLOTWRITER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace libcmaes
+{
+  /**
+   * \brief fields of the binary plot file, see Parameters::set_fplot_binary().
+   */
+  enum FPlotField
+  {
+    FPLOT_SCALARS = 0, // |best f-value|, fevals, sigma, axis ratio, best seen f-value, median f-value, worst seen f-value, min eigenvalue, max eigenvalue, last iteration time (ms).
+    FPLOT_XBEST = 1, // best seen candidate, dim values.
+    FPLOT_EIGENVALUES = 2, // eigenvalues of the covariance matrix, dim values.
+    FPLOT_STDS = 3, // standard deviations, dim values.
+    FPLOT_XMEAN = 4, // mean in phenotype space, dim values.
+    FPLOT_PHASES = 5, // last latency of every phase (ms), PHASE_COUNT values.
+    FPLOT_NFIELDS = 6
+  };
+
+  /**
+   * \brief writer of the binary plot file. Records are appended to a buffer that a
+   *        background thread writes out once full, so that the optimization loop
+   *        neither formats nor flushes anything.
+   *
+   *        Layout, in host byte order:
+   *        - header: magic "LCMAESFP", uint32 version, uint32 dim, uint64 seed,
+   *          uint32 number of fields, uint32 reserved;
+   *        - per field: uint32 id, uint32 number of values, uint32 decimation, uint32 reserved;
+   *        - per generation: int64 iteration, uint32 mask of the fields present,
+   *          uint32 reserved, then the values of the present fields as doubles,
+   *          in field order.
+   *        A field with decimation k is present every k generations, never when k is 0.
+   */
+  class FPlotWriter
+  {
+  public:
+    static const uint32_t _version = 1;
+
+    /**
+     * \brief opens the file and writes its header.
+     * @param filename output file
+     * @param dim problem dimension
+     * @param seed seed of the run
+     * @param widths number of values per field
+     * @param decimation decimation per field
+     */
+    FPlotWriter(const std::string &filename, const int &dim, const uint64_t &seed,
+		const std::vector<int> &widths, const std::vector<int> &decimation)
+      :_out(filename,std::ios::binary),_decimation(decimation)
+    {
+      std::vector<uint32_t> header = {static_cast<uint32_t>(dim),0,0,static_cast<uint32_t>(widths.size()),0};
+      std::memcpy(&header[1],&seed,sizeof(seed));
+      uint32_t version = _version;
+      _out.write("LCMAESFP",8);
+      _out.write(reinterpret_cast<const char*>(&version),sizeof(version));
+      _out.write(reinterpret_cast<const char*>(header.data()),header.size()*sizeof(uint32_t));
+      for (size_t f=0;f<widths.size();f++)
+	{
+	  uint32_t field[4] = {static_cast<uint32_t>(f),static_cast<uint32_t>(widths[f]),static_cast<uint32_t>(decimation[f]),0};
+	  _out.write(reinterpret_cast<const char*>(field),sizeof(field));
+	}
+      _pending.reserve(_buffer_size);
+      _writing.reserve(_buffer_size);
+      _writer = std::thread(&FPlotWriter::run,this);
+    }
+
+    FPlotWriter(const FPlotWriter&) = delete;
+
+    FPlotWriter& operator=(const FPlotWriter&) = delete;
+
+    ~FPlotWriter()
+    {
+      hand_over();
+      {
+	std::lock_guard<std::mutex> lock(_mtx);
+	_stopping = true;
+      }
+      _changed.notify_all();
+      _writer.join();
+    }
+
+    /**
+     * \brief whether the output file could be opened.
+     */
+    bool good() const
+    {
+      return static_cast<bool>(_out);
+    }
+
+    /**
+     * \brief starts the record of a generation.
+     * @param niter iteration
+     */
+    void begin(const int64_t &niter)
+    {
+      _niter = niter;
+      _record = _pending.size();
+      uint32_t mask[2] = {0,0};
+      append(&niter,sizeof(niter));
+      append(mask,sizeof(mask));
+    }
+
+    /**
+     * \brief whether field f is due in the current record. Fields must be
+     *        written in increasing order.
+     */
+    bool due(const int &f) const
+    {
+      return _decimation[f] > 0 && _niter % _decimation[f] == 0;
+    }
+
+    /**
+     * \brief appends the values of field f to the current record.
+     */
+    void put(const int &f, const double *values, const int &n)
+    {
+      uint32_t mask;
+      std::memcpy(&mask,&_pending[_record+sizeof(int64_t)],sizeof(mask));
+      mask |= 1u << f;
+      std::memcpy(&_pending[_record+sizeof(int64_t)],&mask,sizeof(mask));
+      append(values,n*sizeof(double));
+    }
+
+    /**
+     * \brief ends the current record, handing the buffer over to the writer thread when full.
+     */
+    void end()
+    {
+      if (_pending.size() >= _buffer_size)
+	hand_over();
+    }
+
+  private:
+    static const size_t _buffer_size = 1 << 20;
+
+    void append(const void *data, const size_t &size)
+    {
+      const char *bytes = static_cast<const char*>(data);
+      _pending.insert(_pending.end(),bytes,bytes+size);
+    }
+
+    // waits for the previous buffer to be written, then passes the pending one.
+    void hand_over()
+    {
+      if (_pending.empty())
+	return;
+      std::unique_lock<std::mutex> lock(_mtx);
+      _changed.wait(lock,[this]{ return _writing.empty(); });
+      std::swap(_pending,_writing);
+      lock.unlock();
+      _changed.notify_all();
+    }
+
+    void run()
+    {
+      std::unique_lock<std::mutex> lock(_mtx);
+      while(true)
+	{
+	  _changed.wait(lock,[this]{ return _stopping || !_writing.empty(); });
+	  if (_writing.empty()) // stopping.
+	    break;
+	  lock.unlock();
+	  _out.write(_writing.data(),_writing.size());
+	  lock.lock();
+	  _writing.clear();
+	  _changed.notify_all();
+	}
+      _out.flush();
+    }
+
+    std::ofstream _out;
+    std::vector<int> _decimation; /**< decimation per field. */
+    int64_t _niter = 0; /**< iteration of the current record. */
+    size_t _record = 0; /**< offset of the current record in the pending buffer. */
+    std::vector<char> _pending; /**< filled by the optimization loop. */
+    std::vector<char> _writing; /**< written by the writer thread, empty when it is idle. */
+    bool _stopping = false;
+    std::mutex _mtx;
+    std::condition_variable _changed;
+    std::thread _writer;
+  };
+}
+
+#endif
@@ -89,7 +89,75 @@ namespace libcmaes
   protected:
     void lambda_inc();
     void reset_search_state();
+
+    /**
+     * \brief initializes a fresh search state from a previous run, according
+     *        to the warm restart parameters.
+     * @param parameters parameters of the fresh search
+     * @param solutions fresh search state
+     * @param prev_solutions solutions of the previous run
+     */
+    static void warm_start(CMAParameters<TGenoPheno> &parameters,
+			   CMASolutions &solutions,
+			   const CMASolutions &prev_solutions);
     void capture_best_solution(CMASolutions &best_run);
+
+    /**
+     * \brief island scheduler status, as returned by an IslandNextFunc.
+     */
+    enum { ISLAND_DONE = -1, ISLAND_WAIT = 0, ISLAND_RUN = 1 };
+
+    /**
+     * \brief fills in the parameters and the regime of the next restart, called
+     *        under the scheduler's lock.
+     * @return ISLAND_RUN to start the restart, ISLAND_WAIT to wait for a running island
+     *         to progress or complete, ISLAND_DONE when no restart is left
+     */
+    typedef std::function<int (CMAParameters<TGenoPheno>&, int&)> IslandNextFunc;
+
+    /**
+     * \brief called under the scheduler's lock with the parameters, regime and final
+     *        solution of a completed restart.
+     */
+    typedef std::function<void (const CMAParameters<TGenoPheno>&, const int&, const CMASolutions&)> IslandDoneFunc;
+
+    /**
+     * \brief called under the scheduler's lock with the parameters, regime and current
+     *        solution of a running restart, after each of its iterations.
+     */
+    typedef std::function<void (const CMAParameters<TGenoPheno>&, const int&, const CMASolutions&)> IslandProgressFunc;
+
+    /**
+     * \brief runs restarts concurrently as independent CMA-ES instances, up to
+     *        CMAParameters::get_islands() at a time. Islands share the budget of
+     *        function evaluations and the best solution found so far, that is
+     *        optionally migrated into their populations. With warm restarts, a new
+     *        island starts from the best completed run.
+     *        Note: islands use their own ask / eval / tell functions.
+     * @param next returns the parameters of the next restart
+     * @param done accounts for a completed restart
+     * @param progress accounts for the iterations of running restarts, optional
+     * @return success or error code, as defined in opti_err.h
+     */
+    int optimize_islands(const IslandNextFunc &next,
+			 const IslandDoneFunc &done,
+			 const IslandProgressFunc &progress=IslandProgressFunc());
+
+    /**
+     * \brief writes the current restart and best run into checkpoints.
+     * @param out checkpoint output
+     */
+    void put_restarts(CheckpointOut &out) const;
+
+    /**
+     * \brief reads what put_restarts() writes, leaving the strategy unchanged.
+     * @param in checkpoint input
+     * @return function that sets the restarts read, empty if the checkpoint is invalid
+     */
+    std::function<void()> get_restarts(CheckpointIn &in);
+
+    int _restart = 0; /**< current restart. */
+    CMASolutions _best_run; /**< best run among the completed restarts. */
   };
 }
 
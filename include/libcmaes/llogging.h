@@ -36,20 +36,23 @@ namespace libcmaes
   static std::string ERROR="ERROR";
   static std::string FATAL="FATAL";
 
-  static std::ostream nullstream(0);
-
 inline std::ostream& LOG(const std::string &severity,std::ostream &out=std::cout)
 {
   out << severity << " - ";
   return out;
 }
 
-inline std::ostream& LOG_IF(const std::string &severity,const bool &condition,std::ostream &out=std::cout)
+// turns a streaming expression into void, so that it can be the branch of a conditional.
+class LogVoidify
 {
-  if (condition)
-    return LOG(severity,out);
-  else return nullstream;
-}
+ public:
+  void operator&(std::ostream&) {}
+};
 }
+
+// like glog, the streamed arguments are not evaluated when the condition is false.
+#define LOG_IF(severity,condition) \
+  !(condition) ? (void)0 : libcmaes::LogVoidify() & libcmaes::LOG(severity)
+
 #endif
 #endif
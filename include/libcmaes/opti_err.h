@@ -35,6 +35,8 @@ enum {
   OPTI_ERR_OUTOFMEMORY=-1025,
   /* invalid number of variables specified. */
   OPTI_ERR_INVALID_N=-1026,
+  /* checkpoint cannot be read, or does not match the problem. */
+  OPTI_ERR_CHECKPOINT=-1027,
   /* the algorithm has reached a termination criteria without reaching the objective. */
   OPTI_ERR_TERMINATION=-1
 };
@@ -29,11 +29,26 @@
 #include <cmath>
 #include <limits>
 #include <unordered_map>
+#include <vector>
 #include <map>
 #include <chrono>
 
 namespace libcmaes
 {
+  /**
+   * \brief random streams derived from the seed in deterministic mode, sampling uses the seed itself.
+   */
+  enum RandomStream
+  {
+    STREAM_MEAN = 1, // initial mean.
+    STREAM_VD = 2, // initial vd-cma vector.
+    STREAM_UH = 3, // uncertainty handling selection.
+    STREAM_UH_MUTATION = 4, // uncertainty handling mutations.
+    STREAM_BIPOP = 5, // bipop regimes.
+    STREAM_SURROGATE = 6, // surrogate pre-selection.
+    STREAM_CRN = 7 // common random numbers, see set_crn().
+  };
+  
   /**
    * \brief Generic class for Evolution Strategy parameters.
    */
@@ -360,6 +375,54 @@ namespace libcmaes
       {
 	return _quiet;
       }
+
+      /**
+       * \brief sets the number of iterations between two progress lines, 1 by default.
+       * @param every number of iterations
+       */
+      void set_log_every(const int &every)
+      {
+	_log_every = every < 1 ? 1 : every;
+      }
+
+      /**
+       * \brief returns the number of iterations between two progress lines.
+       * @return number of iterations
+       */
+      inline int get_log_every() const
+      {
+	return _log_every;
+      }
+
+      /**
+       * \brief activates / deactivates the structured progress lines, as space separated
+       *        key=value pairs instead of text.
+       * @param kv whether to activate / deactivate
+       */
+      void set_log_kv(const bool &kv)
+      {
+	_log_kv = kv;
+      }
+
+      /**
+       * \brief whether progress lines are structured.
+       * @return whether progress lines are key=value pairs
+       */
+      inline bool get_log_kv() const
+      {
+	return _log_kv;
+      }
+
+      /**
+       * \brief whether a progress line is due at an iteration, i.e. the quiet mode
+       *        is off and the iteration falls on the log period.
+       * @param niter iteration
+       * @return whether to log progress
+       */
+      inline bool log_due(const int &niter) const
+      {
+	return !_quiet && niter % _log_every == 0;
+      }
       
       /**
        * \brief sets the optimization algorithm.
@@ -423,6 +486,103 @@ namespace libcmaes
       {
 	return _fplot;
       }
+
+      /**
+       * \brief activates periodic checkpoints of the search state, written from a
+       *        background thread. Each checkpoint replaces the previous one.
+       *        Restarts run as islands are not checkpointed.
+       * @param filename checkpoint file, empty to deactivate
+       * @param every number of iterations between two checkpoints
+       */
+      void set_checkpoint(const std::string &filename, const int &every=100)
+      {
+	_checkpoint_file = filename;
+	_checkpoint_every = every < 1 ? 1 : every;
+      }
+
+      /**
+       * \brief returns the checkpoint file.
+       * @return checkpoint file, empty when deactivated
+       */
+      inline std::string get_checkpoint_file() const
+      {
+	return _checkpoint_file;
+      }
+
+      /**
+       * \brief returns the number of iterations between two checkpoints.
+       * @return number of iterations
+       */
+      inline int get_checkpoint_every() const
+      {
+	return _checkpoint_every;
+      }
+
+      /**
+       * \brief activates / deactivates resuming from the checkpoint file, when it exists,
+       *        so that a run that crashed continues exactly as it would have. The
+       *        other parameters must be those of the run that wrote the checkpoint.
+       * @param r whether to resume
+       */
+      void set_resume(const bool &r)
+      {
+	_resume = r;
+      }
+
+      /**
+       * \brief whether to resume from the checkpoint file.
+       * @return whether to resume
+       */
+      inline bool get_resume() const
+      {
+	return _resume;
+      }
+
+      /**
+       * \brief activates / deactivates the binary output to file: a columnar file written by a
+       *        background thread, see FPlotWriter for its layout and python/cma_fplot.py for
+       *        reading it or converting it to the text output. The binary output replaces
+       *        the plot function, and holds the full output plus the latency of every phase.
+       * @param b whether to activate / deactivate
+       */
+      void set_fplot_binary(const bool &b)
+      {
+	_fplot_binary = b;
+      }
+
+      /**
+       * \brief whether the output to file is binary.
+       * @return whether the output to file is binary
+       */
+      inline bool get_fplot_binary() const
+      {
+	return _fplot_binary;
+      }
+
+      /**
+       * \brief sets the decimation of a field of the binary output, written every
+       *        given number of iterations, never when 0. All fields are written every iteration by default.
+       * @param field field, see FPlotField
+       * @param every number of iterations
+       */
+      void set_fplot_decimation(const int &field, const int &every)
+      {
+	if (field < 0 || every < 0)
+	  return;
+	if (static_cast<int>(_fplot_decimation.size()) <= field)
+	  _fplot_decimation.resize(field+1,1);
+	_fplot_decimation[field] = every;
+      }
+
+      /**
+       * \brief returns the decimation of a field of the binary output.
+       * @param field field, see FPlotField
+       * @return number of iterations between two writes of the field, 0 for never
+       */
+      inline int get_fplot_decimation(const int &field) const
+      {
+	return (field >= 0 && field < static_cast<int>(_fplot_decimation.size())) ? _fplot_decimation[field] : 1;
+      }
       
       /**
        * \brief activates the gradient injection scheme. 
@@ -480,6 +640,139 @@ namespace libcmaes
       {
 	return _mt_feval;
       }
+
+      /**
+       * \brief activates the recording of a timeline of the optimization: generations, their
+       *        phases and every objective function call, with thread, candidate and f-value.
+       *        The timeline is written as Chrome trace JSON when optimization completes,
+       *        to be opened in chrome://tracing or https://ui.perfetto.dev.
+       * @param filename output file, empty to deactivate
+       * @see Tracer
+       */
+      void set_trace_file(const std::string &filename)
+      {
+	_trace_file = filename;
+      }
+
+      /**
+       * \brief returns the timeline output file, empty when deactivated
+       * @return output file
+       */
+      inline std::string get_trace_file() const
+      {
+	return _trace_file;
+      }
+
+      /**
+       * \brief activates / deactivates the timing of the phases of every optimization step
+       *        (ask, eval, tell and their parts), on by default. When off, a timed phase costs
+       *        a single branch.
+       * @param t true for activated, false otherwise
+       * @see CMASolutions::phase_stats
+       */
+      void set_phase_timing(const bool &t)
+      {
+	_phase_timing = t;
+      }
+
+      /**
+       * \brief returns whether the timing of phases is activated
+       * @return activation status
+       */
+      inline bool get_phase_timing() const
+      {
+	return _phase_timing;
+      }
+
+      /**
+       * \brief activates the deterministic mode: every random draw (initial mean, sampling,
+       *        uncertainty handling, BIPOP regimes, surrogates) comes from a stream derived from
+       *        the seed, and linear algebra runs single-threaded so that reductions keep a fixed
+       *        order. Two runs with the same seed then yield identical solutions, whatever the
+       *        number of threads used for parallel function evaluations.
+       *        Note: concurrent restarts (islands) remain scheduling-dependent.
+       * @param d true for activated, false otherwise
+       */
+      void set_deterministic(const bool &d)
+      {
+	_deterministic = d;
+      }
+
+      /**
+       * \brief returns whether the deterministic mode is activated
+       * @return activation status
+       */
+      inline bool get_deterministic() const
+      {
+	return _deterministic;
+      }
+
+      /**
+       * \brief returns the seed of an independent random stream, derived from the main seed.
+       * @param stream stream identifier
+       * @param index index of the draw within the stream, e.g. the restart number
+       * @return stream seed
+       */
+      inline uint64_t stream_seed(const uint64_t &stream, const uint64_t &index=0) const
+      {
+	uint64_t z = _seed + 0x9e3779b97f4a7c15ULL * ((index << 8) + stream + 1); // splitmix64.
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+      }
+
+      /**
+       * \brief activates common random numbers: all objective function calls of a generation,
+       *        including uncertainty handling re-evaluations and surrogate test sets, see the
+       *        same evaluation context, whose seed changes from one generation to the next.
+       *        Stochastic objective functions, e.g. simulations over random instances, read it
+       *        with eval_context() so that candidates of a generation are ranked on identical draws.
+       * @param crn true for activated, false otherwise
+       */
+      void set_crn(const bool &crn)
+      {
+	_crn = crn;
+      }
+
+      /**
+       * \brief returns whether common random numbers are activated
+       * @return activation status
+       */
+      inline bool get_crn() const
+      {
+	return _crn;
+      }
+
+      /**
+       * \brief activates the cache of objective function values: points whose
+       *        quantized phenotypes match are evaluated only once. Requires a
+       *        deterministic objective function.
+       * @param size max number of cached values, 0 deactivates the cache
+       * @param quantum size of the grid on which points are quantized, 0 for exact matches
+       */
+      void set_eval_cache(const int &size, const double &quantum=0.0)
+      {
+	_eval_cache_size = size;
+	_eval_cache_quantum = quantum;
+      }
+
+      /**
+       * \brief returns the max number of cached objective function values.
+       * @return cache size, 0 when deactivated
+       */
+      inline int get_eval_cache_size() const
+      {
+	return _eval_cache_size;
+      }
+
+      /**
+       * \brief returns the quantization step of the objective function cache.
+       * @return quantization step
+       */
+      inline double get_eval_cache_quantum() const
+      {
+	return _eval_cache_quantum;
+      }
       
       /**
        * \brief sets maximum history size, allows to keep memory requirements fixed.
@@ -560,8 +853,12 @@ namespace libcmaes
       int _max_fevals = -1; /**< max budget as number of function evaluations. */
       
       bool _quiet = true; /**< quiet all outputs. */
+      int _log_every = 1; /**< number of iterations between two progress lines. */
+      bool _log_kv = false; /**< whether progress lines are key=value pairs. */
       std::string _fplot = ""; /**< plotting file, if specified. */
       bool _full_fplot = false; /**< whether to write to file full legacy data output. */
+      bool _fplot_binary = false; /**< whether to write to file in binary format. */
+      std::vector<int> _fplot_decimation; /**< decimation per field of the binary output, 1 when unset. */
       dVec _x0min; /**< initial mean vector min bound value for all components. */
       dVec _x0max; /**< initial mean vector max bound value for all components. */
       double _ftarget = -std::numeric_limits<double>::infinity(); /**< optional objective function target value. */
@@ -579,6 +876,16 @@ namespace libcmaes
       TGenoPheno _gp; /**< genotype / phenotype object. */
       
       bool _mt_feval = false; /**< whether to force multithreaded (i.e. parallel) function evaluations. */ 
+      std::string _trace_file = ""; /**< timeline output file, if specified. */
+      std::string _checkpoint_file = ""; /**< checkpoint file, if specified. */
+      int _checkpoint_every = 100; /**< number of iterations between two checkpoints. */
+      bool _resume = false; /**< whether to resume from the checkpoint file. */
+      bool _phase_timing = true; /**< whether phases of optimization steps are timed. */
+      bool _deterministic = false; /**< whether random draws come from seed-derived streams and reductions keep a fixed order. */
+      uint64_t _mean_draws = 0; /**< number of initial means drawn so far, in deterministic mode. */
+      bool _crn = false; /**< whether objective function calls of a generation share their evaluation context seed. */
+      int _eval_cache_size = 0; /**< max number of cached objective function values, 0 when deactivated. */
+      double _eval_cache_quantum = 0.0; /**< quantization step of cached points, 0 for exact matches. */
       int _max_hist = -1; /**< max size of the history, keeps memory requirements fixed. */
 
       bool _maximize = false; /**< convenience option of maximizing -f instead of minimizing f. */
@@ -0,0 +1,274 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PHASETIMERS_H
+#define PHASETIMERS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <libcmaes/tracer.h>
+
+namespace libcmaes
+{
+  /**
+   * \brief phases of an optimization step that are timed, see CMASolutions::phase_stats().
+   */
+  enum Phase
+  {
+    PHASE_ASK = 0, // sampling of a new population, eigendecomposition included.
+    PHASE_EIGEN = 1, // eigendecomposition of the covariance matrix.
+    PHASE_PHENO = 2, // genotype to phenotype transform of the population.
+    PHASE_EVAL = 3, // objective function calls of a population, re-evaluations included.
+    PHASE_TELL = 4, // update of the distribution, sort and covariance update included.
+    PHASE_SORT = 5, // ranking of the candidates.
+    PHASE_COV_UPDATE = 6, // step-size and covariance matrix update.
+    PHASE_STOP = 7, // termination criteria.
+    PHASE_UH = 8, // uncertainty handling ranking, part of tell.
+    PHASE_SURR_TRAIN = 9, // surrogate training.
+    PHASE_SURR_PREDICT = 10, // surrogate predictions.
+    PHASE_UH_EVAL = 11, // uncertainty handling re-evaluations, part of eval.
+    PHASE_COUNT = 12
+  };
+
+  /**
+   * \brief timing statistics of a phase, in nanoseconds from a monotonic clock.
+   *        Latencies are accumulated into a histogram with power of two buckets:
+   *        bucket b holds the latencies in [2^(b-1),2^b[, bucket 0 the null ones.
+   */
+  class PhaseStats
+  {
+  public:
+    static const int _nbuckets = 64;
+
+    PhaseStats()
+    {
+      reset();
+    }
+
+    ~PhaseStats() {}
+
+    /**
+     * \brief adds a latency.
+     * @param ns latency in nanoseconds
+     */
+    inline void add(const uint64_t &ns)
+    {
+      ++_count;
+      _total += ns;
+      _last = ns;
+      if (ns < _min)
+	_min = ns;
+      if (ns > _max)
+	_max = ns;
+      int b = 0;
+      for (uint64_t v=ns;v;v>>=1)
+	++b;
+      ++_histo[b == _nbuckets ? _nbuckets-1 : b];
+    }
+
+    void reset()
+    {
+      _count = _total = _last = _max = 0;
+      _min = std::numeric_limits<uint64_t>::max();
+      for (int b=0;b<_nbuckets;b++)
+	_histo[b] = 0;
+    }
+
+    /**
+     * \brief returns the number of timed calls.
+     * @return number of calls
+     */
+    inline uint64_t count() const
+    {
+      return _count;
+    }
+
+    /**
+     * \brief returns the cumulative time of the phase.
+     * @return cumulative time in nanoseconds
+     */
+    inline uint64_t total() const
+    {
+      return _total;
+    }
+
+    /**
+     * \brief returns the latency of the last timed call.
+     * @return latency in nanoseconds
+     */
+    inline uint64_t last() const
+    {
+      return _last;
+    }
+
+    /**
+     * \brief returns the smallest latency, 0 when the phase was never timed.
+     * @return latency in nanoseconds
+     */
+    inline uint64_t min() const
+    {
+      return _count ? _min : 0;
+    }
+
+    /**
+     * \brief returns the largest latency.
+     * @return latency in nanoseconds
+     */
+    inline uint64_t max() const
+    {
+      return _max;
+    }
+
+    /**
+     * \brief returns the mean latency.
+     * @return latency in nanoseconds
+     */
+    inline double mean() const
+    {
+      return _count ? static_cast<double>(_total) / static_cast<double>(_count) : 0.0;
+    }
+
+    /**
+     * \brief returns the number of latencies in a histogram bucket.
+     * @param b bucket, in [0,_nbuckets[
+     * @return number of latencies
+     */
+    inline uint64_t bucket(const int &b) const
+    {
+      return _histo[b];
+    }
+
+    /**
+     * \brief returns an upper bound of the q-quantile of latencies, i.e. the
+     *        upper end of the bucket it falls into.
+     * @param q quantile, in [0,1]
+     * @return latency in nanoseconds
+     */
+    uint64_t quantile(const double &q) const
+    {
+      if (!_count)
+	return 0;
+      uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(_count - 1)) + 1;
+      uint64_t seen = 0;
+      for (int b=0;b<_nbuckets;b++)
+	if ((seen += _histo[b]) >= rank)
+	  return b == 0 ? 0 : std::min(_max,(b == _nbuckets-1 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << b) - 1));
+      return _max;
+    }
+
+  private:
+    uint64_t _count; /**< number of timed calls. */
+    uint64_t _total; /**< cumulative latency. */
+    uint64_t _last; /**< latency of the last call. */
+    uint64_t _min; /**< smallest latency. */
+    uint64_t _max; /**< largest latency. */
+    uint64_t _histo[_nbuckets]; /**< latencies per power of two bucket. */
+  };
+
+  /**
+   * \brief timing statistics of all phases, on by default. When off, timing a phase
+   *        costs a single branch.
+   */
+  class PhaseTimers
+  {
+  public:
+    typedef std::chrono::steady_clock clock;
+
+    PhaseTimers() {}
+
+    ~PhaseTimers() {}
+
+    inline bool enabled() const
+    {
+      return _enabled;
+    }
+
+    inline void set_enabled(const bool &e)
+    {
+      _enabled = e;
+    }
+
+    inline const PhaseStats& stats(const int &p) const
+    {
+      return _stats[p];
+    }
+
+    inline void add(const int &p, const clock::time_point &tstart)
+    {
+      _stats[p].add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now()-tstart).count()));
+    }
+
+    void reset()
+    {
+      for (int p=0;p<PHASE_COUNT;p++)
+	_stats[p].reset();
+    }
+
+    /**
+     * \brief returns the name of a phase, e.g. for reports.
+     * @param p phase
+     * @return phase name
+     */
+    static const char* name(const int &p)
+    {
+      static const char *names[PHASE_COUNT] = {"ask","eigen","pheno","eval","tell","sort","cov_update","stop","uh","surr_train","surr_predict","uh_eval"};
+      return (p >= 0 && p < PHASE_COUNT) ? names[p] : "";
+    }
+
+  private:
+    bool _enabled = true; /**< whether phases are timed. */
+    PhaseStats _stats[PHASE_COUNT];
+  };
+
+  /**
+   * \brief times the enclosing scope as one call of a phase, and records it as a span
+   *        when a tracer is given.
+   */
+  class PhaseTimer
+  {
+  public:
+    PhaseTimer(PhaseTimers &timers, const int &p, Tracer *tracer=nullptr)
+      :_timers(timers),_p(p),_on(timers.enabled()),_tracer(tracer)
+    {
+      if (_on || _tracer)
+	_tstart = PhaseTimers::clock::now();
+    }
+
+    ~PhaseTimer()
+    {
+      if (_on)
+	_timers.add(_p,_tstart);
+      if (_tracer)
+	_tracer->span(PhaseTimers::name(_p),_tstart);
+    }
+
+  private:
+    PhaseTimers &_timers;
+    int _p;
+    bool _on; /**< whether timers were enabled on entering the scope. */
+    Tracer *_tracer; /**< records the phase as a span, when not null. */
+    PhaseTimers::clock::time_point _tstart;
+  };
+}
+
+#endif
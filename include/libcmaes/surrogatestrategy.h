@@ -73,7 +73,11 @@ namespace libcmaes
      * @return training status
      */
     int train(const std::vector<Candidate> &candidates,
-	      const dMat &cov) { return _train(candidates,cov); }
+	      const dMat &cov)
+    {
+      PhaseTimer ptimer(this->_solutions._timers,PHASE_SURR_TRAIN,this->_tracer.get());
+      return _train(candidates,cov);
+    }
 
     /**
      * \brief predict from a surrogate model
@@ -82,7 +86,11 @@ namespace libcmaes
      * @return prediction status
      */
     int predict(std::vector<Candidate> &candidates,
-		const dMat &cov) { return _predict(candidates,cov); }
+		const dMat &cov)
+    {
+      PhaseTimer ptimer(this->_solutions._timers,PHASE_SURR_PREDICT,this->_tracer.get());
+      return _predict(candidates,cov);
+    }
 
     /**
      * \brief compute surrogate model error (copies and sorts the test_set)
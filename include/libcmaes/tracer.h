@@ -0,0 +1,181 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace libcmaes
+{
+  /**
+   * \brief timeline of the optimizer's activity, written in the Chrome trace event
+   *        format (chrome://tracing, https://ui.perfetto.dev). Spans are recorded by
+   *        every thread into its own buffer, without locking, and gathered when the
+   *        trace is written, once recording threads are done.
+   * @see Parameters::set_trace_file
+   */
+  class Tracer
+  {
+  public:
+    typedef std::chrono::steady_clock clock;
+
+    Tracer()
+      :_id(++next_id()),_epoch(clock::now())
+    {
+    }
+
+    ~Tracer() {}
+
+    /**
+     * \brief records a span that ends now, on the calling thread.
+     * @param name span name, a string literal or any string that outlives the tracer
+     * @param tstart span start
+     * @param id candidate or generation the span relates to, -1 for none
+     * @param fvalue objective function value, NaN for none
+     */
+    void span(const char *name, const clock::time_point &tstart,
+	      const int &id=-1, const double &fvalue=std::numeric_limits<double>::quiet_NaN())
+    {
+      clock::time_point tstop = clock::now();
+      Span s;
+      s._name = name;
+      s._start = std::chrono::duration_cast<std::chrono::nanoseconds>(tstart-_epoch).count();
+      s._duration = std::chrono::duration_cast<std::chrono::nanoseconds>(tstop-tstart).count();
+      s._id = id;
+      s._fvalue = fvalue;
+      local()._spans.push_back(s);
+    }
+
+    /**
+     * \brief writes all recorded spans as Chrome trace JSON, threads as tracks.
+     *        No thread may record spans meanwhile.
+     * @param filename output file
+     * @return true on success
+     */
+    bool write(const std::string &filename) const
+    {
+      std::ofstream out(filename);
+      if (!out)
+	return false;
+      out.precision(std::numeric_limits<double>::digits10);
+      out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+      bool first = true;
+      std::lock_guard<std::mutex> lock(_mtx);
+      for (const std::unique_ptr<Buffer> &b : _buffers)
+	{
+	  out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->_tid
+	      << ",\"args\":{\"name\":\"thread " << b->_tid << "\"}}";
+	  first = false;
+	  for (const Span &s : b->_spans)
+	    {
+	      out << ",\n{\"name\":\"" << s._name << "\",\"cat\":\"libcmaes\",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->_tid
+		  << ",\"ts\":" << s._start / 1e3 << ",\"dur\":" << s._duration / 1e3 << ",\"args\":{";
+	      if (s._id >= 0)
+		out << "\"id\":" << s._id;
+	      if (!std::isnan(s._fvalue))
+		{
+		  out << (s._id >= 0 ? "," : "") << "\"fvalue\":";
+		  if (std::isfinite(s._fvalue))
+		    out << s._fvalue;
+		  else out << "\"" << s._fvalue << "\""; // JSON has no infinity.
+		}
+	      out << "}}";
+	    }
+	}
+      out << "\n]}\n";
+      return static_cast<bool>(out);
+    }
+
+  private:
+    struct Span
+    {
+      const char *_name;
+      int64_t _start; /**< nanoseconds since the tracer was built. */
+      int64_t _duration; /**< nanoseconds. */
+      int _id;
+      double _fvalue;
+    };
+
+    struct Buffer
+    {
+      int _tid; /**< thread number, in order of first span over the process. */
+      std::deque<Span> _spans; /**< appended by its thread only, elements never move. */
+    };
+
+    /**
+     * \brief returns the calling thread's buffer. Only the first span of a thread,
+     *        or of a thread switching between tracers, takes the lock.
+     */
+    Buffer& local()
+    {
+      struct Cache { uint64_t _tracer = 0; Buffer *_buffer = nullptr; };
+      static thread_local Cache cache;
+      if (cache._tracer == _id)
+	return *cache._buffer;
+      int tid = thread_number();
+      std::lock_guard<std::mutex> lock(_mtx);
+      Buffer *buffer = nullptr;
+      for (const std::unique_ptr<Buffer> &b : _buffers)
+	if (b->_tid == tid)
+	  buffer = b.get();
+      if (!buffer)
+	{
+	  _buffers.push_back(std::unique_ptr<Buffer>(new Buffer()));
+	  buffer = _buffers.back().get();
+	  buffer->_tid = tid;
+	}
+      cache._tracer = _id;
+      cache._buffer = buffer;
+      return *buffer;
+    }
+
+    static int thread_number()
+    {
+      static std::atomic<int> next(0);
+      static thread_local int tid = next++;
+      return tid;
+    }
+
+    static std::atomic<uint64_t>& next_id()
+    {
+      static std::atomic<uint64_t> id(0);
+      return id;
+    }
+
+    const uint64_t _id; /**< unique over the process, so that thread caches never mistake tracers. */
+    const clock::time_point _epoch;
+    mutable std::mutex _mtx; /**< guards the list of buffers. */
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+  };
+}
+
+#endif
@@ -1,101 +0,0 @@
-//
-// Created by deikare on 14.06.23.
-//
-
-#include <vector>
-#include "Palette.h"
-
-#ifndef LIBCMAES_BESTSOLUTION_H
-#define LIBCMAES_BESTSOLUTION_H
-const std::vector<double> resultWeights = {-0.115859, 0.017344, 0.186229, 0.210851, 0.178531, -0.298112, -0.047654,
-                                           -0.024351, 0.008697, 0.294544, 0.085211, 0.021743, 0.015323, -0.638729,
-                                           -0.222279, -0.023954, 0.221605, -0.203180, -0.134548, -0.071854, 0.226469,
-                                           -0.037622, -0.117267, 0.090844, 0.077236, 0.227475, -0.014852, -0.071097,
-                                           -0.342399, -0.024708, 0.321383, -0.108276, -0.058857, 0.233140, 0.011497,
-                                           -0.162087, -0.228312, -0.005305, -0.131900, 0.350921, -0.180658, -0.143866,
-                                           -0.172807, -0.031664, 0.019207, 0.041783, -0.094361, 0.103286, -0.166151,
-                                           0.153899, 0.057688, 0.185783, -0.017065, -0.005317, 0.150778, 0.060355,
-                                           0.010336, 0.028532, -0.072501, 0.037194, 0.143617, 0.327278, -0.126802,
-                                           0.044873, -0.207549, -0.075231, -0.062200, 0.071728, 0.091751, -0.049326,
-                                           0.205337, 0.164734, -0.203119, 0.130192, 0.213163, -0.114282, -0.037610,
-                                           0.192621, 0.176787, -0.214565, 0.361223, -0.250582, -0.197622, -0.013527,
-                                           0.025642, -0.218712, 0.268527, 0.210975, -0.194698, 0.048239, -0.200583,
-                                           -0.047616, 0.142995, 0.256518, -0.038971, 0.244807, -0.021564, -0.252895,
-                                           -0.006082, -0.061894, -0.087968, 0.117953, -0.193021, -0.216847, -0.005177,
-                                           -0.236432, 0.075002, -0.114034, 0.072123, 0.006722, 0.161667, -0.279169,
-                                           -0.132381, 0.013743, 0.182914, -0.114339, -0.256185, -0.041615, 0.034875,
-                                           -0.184284, -0.133118, 0.051914, 0.102449, 0.004660, 0.245508, -0.072050,
-                                           -0.114078, 0.094593, 0.140920, 0.045658, -0.012894, -0.178724, 0.074095,
-                                           0.077982, 0.014506, 0.085571, -0.078170, 0.163025, -0.117067, 0.001767,
-                                           0.033050, -0.003203, -0.035549, 0.148122, -0.179683, -0.195860, 0.000250,
-                                           0.173123, 0.216981, -0.017877, -0.144239, 0.033425, 0.027037, -0.164466,
-                                           -0.027497, 0.024618, 0.122273, -0.090543, -0.074003, 0.098015, -0.013586,
-                                           0.049490, 0.018377, -0.004854, 0.218736, -0.165663, -0.045618, -0.135011,
-                                           -0.148452, 0.096414, 0.003335, -0.060660, 0.136114, -0.099565, 0.246217,
-                                           -0.066898, 0.037752, 0.143506, -0.084580, 0.321105, -0.375714, -0.149724,
-                                           0.062793, -0.219294, 0.156872, 0.062857, 0.047316, -0.190287, 0.140798,
-                                           -0.043035, -0.045072, 0.161365, -0.023820, -0.134561, 0.332963, 0.037618,
-                                           0.023866, -0.115973, -0.106497, -0.203523, 0.193567, -0.014353, 0.017483,
-                                           -0.117329, -0.045771, -0.068079, -0.093668, -0.266379, -0.056826, -0.127383,
-                                           0.369788, 0.024877, -0.347276, -0.092613, 0.244338, -0.119216, 0.137635,
-                                           0.003437, -0.144958, -0.074912, -0.038571, 0.085497, 0.506711, -0.214627,
-                                           -0.002611};
-const std::vector<std::list<ItemTypeTuple >> itemTypesVector = {
-        {{{18,  15},  11}, {{19,  16},  35}, {{16,  15},  23}, {{11,  13},  49}, {{18,  19},  27}},
-        {{{24,  63},  35}, {{47,  83},  24}, {{96,  21},  34}, {{91,  93},  16}, {{40,  26},  13}},
-        {{{180, 698}, 33}, {{798, 513}, 38}, {{466, 57},  25}, {{688, 315}, 24}, {{328, 21},  26}},
-        {{{13,  10},  35}, {{12,  13},  15}, {{17,  10},  8},  {{11,  14},  36}, {{12,  16},  10}, {{18,  15},  30}, {{13,  17},  6},  {{18,  14},  10}, {{14,  18},  25}, {{11,  15},  37}},
-        {{{37,  47},  23}, {{66,  75},  38}, {{13,  64},  41}, {{83,  32},  26}, {{63,  34},  49}, {{54,  14},  5},  {{64,  36},  4},  {{93,  52},  36}, {{88,  42},  27}, {{98,  10},  14}},
-        {{{673, 741}, 24}, {{544, 263}, 30}, {{924, 51},  32}, {{936, 980}, 49}, {{193, 518}, 21}, {{769, 212}, 33}, {{405, 195}, 45}, {{297, 364}, 27}, {{395, 983}, 42}, {{748, 152}, 22}},
-        {{{10,  15},  11}, {{10,  17},  34}, {{18,  15},  9},  {{16,  10},  23}, {{16,  18},  23}, {{17,  17},  17}, {{11,  10},  2},  {{19,  17},  21}, {{18,  17},  16}, {{17,  18},  45}, {{15,  15},  42}, {{11,  16},  49}, {{16,  19},  12}, {{10,  12},  25}, {{10,  14},  37}, {{17,  15},  28}, {{15,  17},  18}, {{18,  16},  36}, {{12,  15},  16}, {{12,  12},  43}},
-        {{{86,  91},  35}, {{70,  21},  3},  {{99,  88},  36}, {{93,  33},  9},  {{16,  95},  47}, {{50,  56},  45}, {{41,  55},  47}, {{45,  39},  45}, {{26,  38},  27}, {{43,  42},  30}, {{43,  30},  31}, {{77,  30},  18}, {{67,  93},  41}, {{90,  27},  48}, {{92,  66},  4},  {{99,  91},  36}, {{47,  43},  15}, {{68,  47},  6},  {{14,  11},  25}, {{17,  28},  25}},
-        {{{909, 423}, 40}, {{618, 90},  49}, {{589, 988}, 15}, {{53,  18},  32}, {{402, 748}, 24}, {{517, 988}, 13}, {{387, 827}, 4},  {{466, 54},  12}, {{989, 191}, 8},  {{982, 178}, 44}, {{491, 577}, 36}, {{502, 430}, 20}, {{44,  900}, 10}, {{295, 861}, 38}, {{374, 430}, 41}, {{18,  803}, 7},  {{716, 444}, 8},  {{700, 513}, 11}, {{528, 705}, 16}, {{437, 175}, 28}},
-        {{{10,  18},  6},  {{13,  11},  5},  {{19,  14},  47}, {{15,  13},  49}, {{13,  13},  47}},
-        {{{34,  91},  21}, {{20,  13},  11}, {{42,  47},  12}, {{53,  47},  46}, {{24,  88},  9}},
-        {{{114, 454}, 42}, {{386, 782}, 20}, {{257, 937}, 44}, {{489, 564}, 33}, {{650, 680}, 40}},
-        {{{11,  19},  27}, {{14,  11},  6},  {{15,  13},  49}, {{16,  12},  13}, {{16,  18},  3},  {{18,  11},  18}, {{18,  14},  19}, {{17,  18},  17}, {{15,  12},  25}, {{17,  13},  44}},
-        {{{66,  50},  18}, {{70,  86},  31}, {{72,  86},  10}, {{68,  42},  8},  {{59,  83},  16}, {{98,  39},  20}, {{65,  87},  49}, {{24,  58},  42}, {{95,  25},  41}, {{43,  96},  9}},
-        {{{423, 791}, 3},  {{55,  612}, 19}, {{227, 363}, 40}, {{839, 720}, 33}, {{29,  823}, 37}, {{936, 483}, 24}, {{283, 948}, 41}, {{972, 568}, 13}, {{320, 647}, 26}, {{698, 798}, 49}},
-        {{{11,  11},  32}, {{11,  10},  10}, {{16,  15},  6},  {{12,  10},  6},  {{15,  15},  9},  {{12,  14},  39}, {{14,  10},  37}, {{15,  17},  29}, {{10,  13},  25}, {{19,  15},  34}, {{10,  16},  41}, {{16,  12},  41}, {{15,  13},  44}, {{10,  16},  9},  {{19,  19},  3},  {{17,  10},  33}, {{13,  18},  13}, {{12,  10},  37}, {{11,  13},  4},  {{15,  14},  40}},
-        {{{98,  64},  44}, {{96,  43},  41}, {{91,  49},  19}, {{31,  62},  4},  {{73,  39},  35}, {{66,  83},  44}, {{99,  84},  3},  {{98,  48},  3},  {{84,  47},  34}, {{36,  78},  40}, {{22,  73},  18}, {{18,  17},  36}, {{91,  26},  15}, {{79,  62},  41}, {{86,  59},  15}, {{16,  95},  4},  {{46,  35},  20}, {{39,  97},  45}, {{35,  20},  46}, {{58,  19},  22}},
-        {{{407, 986}, 2},  {{294, 775}, 40}, {{335, 568}, 23}, {{393, 660}, 18}, {{514, 266}, 30}, {{439, 878}, 42}, {{882, 896}, 13}, {{247, 180}, 15}, {{608, 495}, 22}, {{980, 311}, 43}, {{824, 437}, 40}, {{574, 437}, 39}, {{801, 308}, 45}, {{900, 404}, 11}, {{361, 925}, 17}, {{756, 650}, 31}, {{536, 805}, 6},  {{383, 969}, 32}, {{138, 93},  46}, {{313, 481}, 33}},
-        {{{12,  17},  37}, {{18,  17},  5},  {{19,  18},  6},  {{15,  12},  19}, {{19,  15},  37}},
-        {{{25,  23},  37}, {{67,  14},  43}, {{61,  37},  6},  {{83,  43},  19}, {{83,  69},  37}},
-        {{{444, 856}, 23}, {{873, 848}, 29}, {{96,  743}, 34}, {{995, 859}, 20}, {{704, 108}, 48}},
-        {{{18,  19},  45}, {{17,  17},  45}, {{14,  19},  26}, {{12,  13},  44}, {{19,  12},  30}, {{16,  14},  46}, {{13,  19},  12}, {{13,  11},  45}, {{14,  15},  26}, {{15,  17},  29}},
-        {{{59,  15},  44}, {{32,  51},  48}, {{99,  31},  46}, {{31,  82},  38}, {{54,  81},  13}, {{87,  65},  39}, {{37,  28},  31}, {{94,  90},  46}, {{61,  60},  49}, {{50,  68},  44}},
-        {{{128, 461}, 19}, {{694, 773}, 23}, {{906, 895}, 35}, {{961, 876}, 11}, {{203, 804}, 26}, {{255, 167}, 17}, {{384, 187}, 20}, {{356, 844}, 34}, {{633, 715}, 14}, {{346, 384}, 49}},
-        {{{14,  16},  35}, {{12,  14},  39}, {{17,  11},  45}, {{17,  18},  22}, {{11,  18},  29}, {{11,  14},  19}, {{18,  10},  32}, {{10,  12},  38}, {{15,  14},  15}, {{10,  16},  45}, {{18,  12},  44}, {{10,  14},  25}, {{11,  19},  21}, {{16,  12},  11}, {{11,  13},  34}, {{19,  10},  37}, {{12,  10},  39}, {{19,  15},  25}, {{13,  16},  21}, {{11,  17},  35}},
-        {{{13,  43},  16}, {{71,  71},  18}, {{62,  22},  41}, {{79,  11},  28}, {{88,  87},  14}, {{93,  53},  49}, {{48,  29},  3},  {{60,  80},  23}, {{59,  79},  38}, {{94,  42},  47}, {{56,  91},  34}, {{46,  48},  9},  {{20,  91},  43}, {{15,  64},  17}, {{61,  35},  25}, {{71,  50},  8},  {{44,  34},  24}, {{93,  38},  14}, {{59,  55},  18}, {{87,  98},  24}},
-        {{{63,  204}, 20}, {{183, 605}, 8},  {{71,  168}, 47}, {{176, 131}, 4},  {{817, 916}, 18}, {{342, 371}, 4},  {{614, 752}, 39}, {{682, 952}, 5},  {{194, 511}, 8},  {{807, 895}, 36}, {{396, 827}, 31}, {{271, 871}, 12}, {{345, 565}, 14}, {{555, 91},  17}, {{726, 485}, 40}, {{15,  639}, 26}, {{545, 492}, 18}, {{695, 401}, 11}, {{933, 403}, 23}, {{582, 559}, 26}}
-};
-const std::vector<std::pair<LengthUnit, LengthUnit>> paletteSizes = {
-        {266,   266},
-        {854,   854},
-        {7176,  7176},
-        {284,   284},
-        {1214,  1214},
-        {13819, 13819},
-        {473,   473},
-        {1976,  1976},
-        {13954, 13954},
-        {206,   206},
-        {548,   548},
-        {7797,  7797},
-        {252,   252},
-        {1129,  1129},
-        {10799, 10799},
-        {345,   345},
-        {1542,  1542},
-        {14149, 14149},
-        {159,   159},
-        {596,   596},
-        {7307,  7307},
-        {286,   286},
-        {1176,  1176},
-        {8976,  8976},
-        {337,   337},
-        {1313,  1313},
-        {10942, 10942}
-};
-#endif //LIBCMAES_BESTSOLUTION_H
@@ -0,0 +1,155 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#ifndef LIBCMAES_FIXEDNEURALNETWORK_H
+#define LIBCMAES_FIXEDNEURALNETWORK_H
+
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <Eigen/Dense>
+#include "NeuralNetwork.h"
+
+// layers of a FixedNeuralNetwork, Previous inputs feeding Current neurons, followed by the Next layers
+template<int Previous, int... Neurons>
+class FixedLayers;
+
+template<int Previous>
+class FixedLayers<Previous> {
+public:
+    static const int outputs = Previous;
+
+    const float *load(const float *parameters) {
+        return parameters;
+    }
+
+    const float *forward(const float *inputs) {
+        return inputs;
+    }
+
+    template<class TActivations>
+    const float *rateBatch(const TActivations &activations, long) {
+        return activations.data();
+    }
+};
+
+template<int Previous, int Current, int... Next>
+class FixedLayers<Previous, Current, Next...> {
+public:
+    static const int outputs = FixedLayers<Current, Next...>::outputs;
+
+    // layout of NeuralNetwork: [previousNeuron][neuron], then the biases
+    const float *load(const float *parameters) {
+        weights = Eigen::Map<const Weights>(parameters);
+        biases = Eigen::Map<const Biases>(parameters + Previous * Current);
+        return next.load(parameters + (Previous + 1) * Current);
+    }
+
+    const float *forward(const float *inputs) {
+        activations.noalias() = weights.transpose() * Eigen::Map<const Eigen::Matrix<float, Previous, 1>>(inputs);
+        activations = (1.0f + (-(activations + biases.transpose()).array()).exp()).inverse().matrix();
+        return next.forward(activations.data());
+    }
+
+    // inputs holds at least Previous columns, the first Previous of them are read
+    template<class TInputs>
+    const float *rateBatch(const TInputs &inputs, long rows) {
+        if (batchActivations.rows() < rows)
+            batchActivations.resize(std::max(rows, 2 * batchActivations.rows()), Current);
+
+        auto values = batchActivations.topRows(rows);
+        values.noalias() = inputs.topRows(rows).template leftCols<Previous>() * weights;
+        values.rowwise() += biases;
+        values.array() = (1.0f + (-values.array()).exp()).inverse();
+        return next.rateBatch(batchActivations, rows);
+    }
+
+private:
+    //unaligned, so that palettes holding the network need no aligned allocation
+    using Weights = Eigen::Matrix<float, Previous, Current, (Current == 1 ? Eigen::ColMajor : Eigen::RowMajor) | Eigen::DontAlign>;
+    using Biases = Eigen::Matrix<float, 1, Current, Eigen::RowMajor | Eigen::DontAlign>;
+
+    Weights weights;
+    Biases biases;
+    Eigen::Matrix<float, Current, 1, Eigen::ColMajor | Eigen::DontAlign> activations;
+    Eigen::Matrix<float, Eigen::Dynamic, Current> batchActivations; //grown on demand
+    FixedLayers<Current, Next...> next;
+};
+
+// NeuralNetwork with its topology fixed at compile time: weights are fixed-size matrices held by value, so products
+// are unrolled and need no allocation. Same interface as NeuralNetwork, usable as the network of a BasicPalette
+template<int Inputs, int... Neurons>
+class FixedNeuralNetwork {
+public:
+    using BatchInputs = NeuralNetwork::BatchInputs;
+
+    static std::vector<int> topology() {
+        return {Inputs, Neurons...};
+    }
+
+    // candidate laid out as for NeuralNetwork(nodesInLayersCount, x)
+    explicit FixedNeuralNetwork(const double *x) {
+        std::vector<float> parameters(NeuralNetwork::parametersNumber(topology()));
+        std::copy(x, x + parameters.size(), parameters.begin());
+        layers.load(parameters.data());
+    }
+
+    // weights[layer][previousNeuron][neuron], the last previousNeuron row of every layer holding the biases
+    explicit FixedNeuralNetwork(const std::vector<std::vector<std::vector<float>>> &weights) {
+        std::vector<int> nodesInLayersCount;
+        std::vector<float> parameters;
+        for (const auto &layer: weights) {
+            if (nodesInLayersCount.empty())
+                nodesInLayersCount.push_back(int(layer.size()) - 1);
+            nodesInLayersCount.push_back(int(layer[0].size()));
+            for (const auto &previousNeuron: layer)
+                parameters.insert(parameters.end(), previousNeuron.begin(), previousNeuron.end());
+        }
+        if (nodesInLayersCount != topology())
+            throw std::invalid_argument("weights do not match the network topology");
+        layers.load(parameters.data());
+    }
+
+    const float *rateBatch(const BatchInputs &inputs, long rows) {
+        return layers.rateBatch(inputs, rows);
+    }
+
+    long selectBest(const BatchInputs &inputs, long rows) {
+        return NeuralNetwork::selectBest(rateBatch(inputs, rows), rows);
+    }
+
+    float rate(const Features &inputs) {
+        return layers.forward(inputs.data())[0];
+    }
+
+    std::vector<float> simulate(const std::vector<float> &inputs) {
+        const float *output = layers.forward(inputs.data());
+        return std::vector<float>(output, output + getOutputSize());
+    }
+
+    long getInputSize() const {
+        return Inputs;
+    }
+
+    long getOutputSize() const {
+        return FixedLayers<Inputs, Neurons...>::outputs;
+    }
+
+private:
+    FixedLayers<Inputs, Neurons...> layers;
+};
+
+// calls visitor with a network over the candidate x, specialized at compile time for the common topologies and a
+// NeuralNetwork otherwise. TVisitor has a result_type and an operator() template over the network type
+template<class TVisitor>
+typename TVisitor::result_type visitNetwork(const std::vector<int> &nodesInLayersCount, const double *x,
+                                            TVisitor &visitor) {
+    if (nodesInLayersCount == FixedNeuralNetwork<52, 4, 2, 1>::topology()) //levels 21, item types 20
+        return visitor(FixedNeuralNetwork<52, 4, 2, 1>(x));
+    return visitor(NeuralNetwork(nodesInLayersCount, x));
+}
+
+
+#endif //LIBCMAES_FIXEDNEURALNETWORK_H
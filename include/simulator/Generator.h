@@ -8,70 +8,64 @@
 
 #include <utility>
 #include "list"
-#include <cstdio>
-#include <cstdlib>
-#include<ctime>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 #include "Palette.h"
 
+struct Instance {
+    std::list<ItemTypeTuple> items;
+    std::pair<LengthUnit, LengthUnit> paletteSize;
+};
+
 class Generator {
 
 public:
-    Generator(int min_length, int max_length, int min_count, int max_count, int items_type_count, double difficulty)
+    // every generator owns its engine, so generators can run concurrently and a given seed always yields the same instances
+    Generator(int min_length, int max_length, int min_count, int max_count, int items_type_count, double difficulty,
+              unsigned long seed = std::random_device{}())
             : min_length(min_length), max_length(max_length), min_count(min_count), max_count(max_count),
-              items_type_count(items_type_count), difficulty(difficulty) {}
+              items_type_count(items_type_count), difficulty(difficulty), engine(seed) {}
+
+    void seed(unsigned long seed) {
+        engine.seed(seed);
+    }
 
     void generate() {
-        srand(time(nullptr));
+        std::uniform_int_distribution<int> lengthDistribution(min_length, max_length - 1);
+        std::uniform_int_distribution<int> countDistribution(min_count, max_count - 1);
 
-        std::list<std::pair<ItemType, unsigned long>> new_items;
+        std::vector<ItemTypeTuple> new_items;
+        new_items.reserve(items_type_count);
 
         for (int i = 0; i < items_type_count; i++) {
-            bool isAdded = false;
-
-            int width = (rand() % (max_length - min_length)) + min_length;
-            int height = (rand() % (max_length - min_length)) + min_length;
-            int count = (rand() % (max_count - min_count)) + min_count;
-
-            std::pair<ItemType, unsigned long> newItem;
-            newItem.first.first = width;
-            newItem.first.second = height;
-            newItem.second = count;
-
-            for (int j = 0; j < new_items.size(); j++) {
-                auto list_front = new_items.begin();
-                std::advance(list_front, j);
-
-                if (list_front->first.first == newItem.first.first &&
-                    list_front->first.second == newItem.first.second) {
-                    list_front->second += newItem.second;
-                    isAdded = true;
-                    break;
-                }
-            }
-
-            if (!isAdded) {
-                new_items.push_back(newItem);
-            }
+            ItemTypeTuple newItem;
+            newItem.first.first = lengthDistribution(engine);
+            newItem.first.second = lengthDistribution(engine);
+            newItem.second = countDistribution(engine);
+
+            auto sameType = std::find_if(new_items.begin(), new_items.end(), [&newItem](const ItemTypeTuple &item) {
+                return item.first == newItem.first;
+            });
+
+            if (sameType != new_items.end())
+                sameType->second += newItem.second;
+            else new_items.push_back(newItem);
         }
 
-        int paletteArea = 0;
+        LengthUnit paletteArea = 0;
 
-        for (auto item : new_items)
+        for (auto &item : new_items)
             paletteArea += item.first.first * item.first.second * item.second;
-//        for(int i = 0; i < new_items.size(); i++){
-//            auto item = new_items.begin();
-//
-//            paletteArea+= item->first.first * item->first.second * item->second;
-//
-//            std::advance(item, 1);
-//        }
 
         LengthUnit d = std::ceil(std::sqrt(double(paletteArea) / difficulty));
         palette_size =  std::make_pair(d, d);
 
 
-        items = new_items;
+        items.assign(new_items.begin(), new_items.end());
     }
 
     std::list<std::pair<ItemType, unsigned long>> getItems() {
@@ -82,6 +76,10 @@ public:
         return palette_size;
     }
 
+    Instance getInstance() const {
+        return Instance{items, palette_size};
+    }
+
 private:
     int min_length;
     int max_length;
@@ -89,10 +87,42 @@ private:
     int max_count;
     int items_type_count;
     double difficulty;
+    std::mt19937 engine;
 
     std::list<std::pair<ItemType, unsigned long>> items;
     std::pair<LengthUnit, LengthUnit> palette_size = std::make_pair(0, 0);
 };
 
+// pre-generated instances, read-only once built so a single pool can be shared by threads and by all candidates
+// of a generation. Instance i only depends on the generator settings, the pool seed and i.
+class InstancePool {
+
+public:
+    InstancePool() = default;
+
+    InstancePool(Generator generator, size_t size, unsigned long seed) {
+        instances.reserve(size);
+        for (size_t i = 0; i < size; i++) {
+            std::seed_seq instanceSeed{uint32_t(seed), uint32_t(uint64_t(seed) >> 32), uint32_t(i)};
+            std::mt19937::result_type engineSeed;
+            instanceSeed.generate(&engineSeed, &engineSeed + 1);
+            generator.seed(engineSeed);
+            generator.generate();
+            instances.push_back(generator.getInstance());
+        }
+    }
+
+    const Instance &operator[](size_t index) const {
+        return instances[index];
+    }
+
+    size_t size() const {
+        return instances.size();
+    }
+
+private:
+    std::vector<Instance> instances;
+};
+
 
 #endif //LIBCMAES_GENERATOR_H
@@ -0,0 +1,211 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#ifndef LIBCMAES_INSTANCECORPUS_H
+#define LIBCMAES_INSTANCECORPUS_H
+
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <list>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Generator.h"
+
+// Binary corpus of bin-packing instances, in host byte order, every record 8 bytes aligned:
+//   CorpusHeader, then instancesNumber CorpusInstance records, then all CorpusItem records.
+// Instance i owns items [firstItem, firstItem + itemTypesNumber).
+
+struct CorpusHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t instancesNumber;
+};
+
+struct CorpusInstance {
+    uint64_t width;
+    uint64_t height;
+    uint64_t firstItem;
+    uint64_t itemTypesNumber;
+};
+
+struct CorpusItem {
+    uint64_t width;
+    uint64_t height;
+    uint64_t count;
+};
+
+static const char corpusMagic[8] = {'P', 'B', 'A', 'D', 'C', 'R', 'P', 'S'};
+static const uint32_t corpusVersion = 1;
+
+// instance read in place from a corpus, valid as long as its corpus
+class InstanceView {
+public:
+    InstanceView(const CorpusInstance &instance, const CorpusItem *items) : instance(instance), items(items) {}
+
+    std::pair<LengthUnit, LengthUnit> getPaletteSize() const {
+        return {instance.width, instance.height};
+    }
+
+    size_t size() const {
+        return instance.itemTypesNumber;
+    }
+
+    const CorpusItem *begin() const {
+        return items;
+    }
+
+    const CorpusItem *end() const {
+        return items + instance.itemTypesNumber;
+    }
+
+    // Palette owns a mutable item list, this is the only copy made
+    std::list<ItemTypeTuple> getItems() const {
+        std::list<ItemTypeTuple> result;
+        for (auto &item: *this)
+            result.push_back({{item.width, item.height}, item.count});
+        return result;
+    }
+
+private:
+    const CorpusInstance &instance;
+    const CorpusItem *items;
+};
+
+// read-only corpus, memory mapped so that threads share its pages and opening is independent of its size
+class InstanceCorpus {
+public:
+    explicit InstanceCorpus(const std::string &path) {
+#ifdef _WIN32
+        std::ifstream input(path, std::ios::binary);
+        if (!input)
+            throw std::runtime_error("cannot open instance corpus " + path);
+        buffer.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        length = buffer.size();
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open instance corpus " + path);
+        struct stat st{};
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            length = size_t(st.st_size);
+            void *mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            data = mapped == MAP_FAILED ? nullptr : static_cast<const char *>(mapped);
+        }
+        close(fd);
+        if (!data)
+            throw std::runtime_error("cannot map instance corpus " + path);
+#endif
+
+        if (length < sizeof(CorpusHeader) || std::memcmp(header().magic, corpusMagic, sizeof(corpusMagic)) != 0 ||
+            header().version != corpusVersion) {
+            release();
+            throw std::runtime_error("not an instance corpus " + path);
+        }
+
+        // the instance table is checked before being read, then every item range against the items left
+        bool truncated = length < sizeof(CorpusHeader) + size() * sizeof(CorpusInstance);
+        size_t itemsNumber = truncated ? 0 : (length - sizeof(CorpusHeader) - size() * sizeof(CorpusInstance)) /
+                                             sizeof(CorpusItem);
+        for (size_t i = 0; i < size() && !truncated; i++)
+            truncated = instances()[i].firstItem > itemsNumber ||
+                        instances()[i].itemTypesNumber > itemsNumber - instances()[i].firstItem;
+        if (truncated) {
+            release();
+            throw std::runtime_error("truncated instance corpus " + path);
+        }
+    }
+
+    InstanceCorpus(const InstanceCorpus &) = delete;
+
+    InstanceCorpus &operator=(const InstanceCorpus &) = delete;
+
+    ~InstanceCorpus() {
+        release();
+    }
+
+    size_t size() const {
+        return header().instancesNumber;
+    }
+
+    InstanceView operator[](size_t index) const {
+        const CorpusInstance &instance = instances()[index];
+        return {instance, items() + instance.firstItem};
+    }
+
+private:
+    const char *data = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#endif
+
+    const CorpusHeader &header() const {
+        return *reinterpret_cast<const CorpusHeader *>(data);
+    }
+
+    const CorpusInstance *instances() const {
+        return reinterpret_cast<const CorpusInstance *>(data + sizeof(CorpusHeader));
+    }
+
+    const CorpusItem *items() const {
+        return reinterpret_cast<const CorpusItem *>(data + sizeof(CorpusHeader) + size() * sizeof(CorpusInstance));
+    }
+
+    void release() {
+#ifndef _WIN32
+        if (data)
+            munmap(const_cast<char *>(data), length);
+#endif
+        data = nullptr;
+    }
+};
+
+// writes instances to a corpus, TInstances is e.g. an InstancePool or a std::vector<Instance>
+template<class TInstances>
+void writeInstanceCorpus(const std::string &path, const TInstances &instances) {
+    std::ofstream output(path, std::ios::binary);
+    if (!output)
+        throw std::runtime_error("cannot write instance corpus " + path);
+
+    CorpusHeader header{};
+    std::memcpy(header.magic, corpusMagic, sizeof(corpusMagic));
+    header.version = corpusVersion;
+    header.instancesNumber = uint32_t(instances.size());
+    output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    uint64_t firstItem = 0;
+    for (size_t i = 0; i < instances.size(); i++) {
+        const Instance &instance = instances[i];
+        CorpusInstance record{instance.paletteSize.first, instance.paletteSize.second, firstItem,
+                              instance.items.size()};
+        output.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        firstItem += instance.items.size();
+    }
+
+    for (size_t i = 0; i < instances.size(); i++) {
+        for (auto &item: instances[i].items) {
+            CorpusItem record{item.first.first, item.first.second, item.second};
+            output.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        }
+    }
+}
+
+
+#endif //LIBCMAES_INSTANCECORPUS_H
@@ -0,0 +1,107 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#ifndef LIBCMAES_NETWORKWEIGHTS_H
+#define LIBCMAES_NETWORKWEIGHTS_H
+
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include "NeuralNetwork.h"
+
+// trained network in a binary file, host byte order: header, layer sizes as int32, then weights as doubles.
+// Weights are ordered as in the optimizer's candidate, see NeuralNetwork(nodesInLayersCount, const double *x)
+// and NeuralNetwork::parametersNumber.
+struct NetworkWeights {
+    std::vector<int> nodesInLayersCount;
+    std::vector<double> weights;
+    double fvalue = 0.0; //objective function value reached by the weights
+    double time = 0.0; //training time, in seconds
+
+    void write(const std::string &path) const {
+        std::ofstream output(path, std::ios::binary);
+        if (!output)
+            throw std::runtime_error("cannot write weights file " + path);
+
+        Header header{};
+        std::memcpy(header.magic, magic(), sizeof(header.magic));
+        header.version = version;
+        header.layersNumber = uint32_t(nodesInLayersCount.size());
+        header.weightsNumber = weights.size();
+        header.fvalue = fvalue;
+        header.time = time;
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        std::vector<int32_t> layers(nodesInLayersCount.begin(), nodesInLayersCount.end());
+        output.write(reinterpret_cast<const char *>(layers.data()), std::streamsize(layers.size() * sizeof(int32_t)));
+        output.write(reinterpret_cast<const char *>(weights.data()), std::streamsize(weights.size() * sizeof(double)));
+    }
+
+    static NetworkWeights read(const std::string &path) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input)
+            throw std::runtime_error("cannot open weights file " + path);
+
+        Header header{};
+        input.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!input || std::memcmp(header.magic, magic(), sizeof(header.magic)) != 0 || header.version != version)
+            throw std::runtime_error("not a weights file " + path);
+
+        // the sizes in the header are bounded by what is left in the file before allocating
+        auto start = input.tellg();
+        input.seekg(0, std::ios::end);
+        uint64_t remaining = uint64_t(input.tellg() - start);
+        input.seekg(start);
+        if (!input || header.layersNumber < 2 || header.layersNumber > remaining / sizeof(int32_t) ||
+            header.weightsNumber > (remaining - header.layersNumber * sizeof(int32_t)) / sizeof(double))
+            throw std::runtime_error("truncated weights file " + path);
+
+        NetworkWeights result;
+        std::vector<int32_t> layers(header.layersNumber);
+        input.read(reinterpret_cast<char *>(layers.data()), std::streamsize(layers.size() * sizeof(int32_t)));
+        if (!input)
+            throw std::runtime_error("truncated weights file " + path);
+
+        // the weights must be those of the network, see NeuralNetwork::parametersNumber
+        result.nodesInLayersCount.assign(layers.begin(), layers.end());
+        if (std::any_of(layers.begin(), layers.end(), [](int32_t nodes) { return nodes <= 0; }) ||
+            header.weightsNumber != NeuralNetwork::parametersNumber(result.nodesInLayersCount))
+            throw std::runtime_error("weights do not match the layers in weights file " + path);
+
+        result.weights.resize(header.weightsNumber);
+        input.read(reinterpret_cast<char *>(result.weights.data()),
+                   std::streamsize(result.weights.size() * sizeof(double)));
+        if (!input)
+            throw std::runtime_error("truncated weights file " + path);
+
+        result.fvalue = header.fvalue;
+        result.time = header.time;
+        return result;
+    }
+
+private:
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t layersNumber;
+        uint64_t weightsNumber;
+        double fvalue;
+        double time;
+    };
+
+    static const uint32_t version = 1;
+
+    static const char *magic() {
+        return "PBADWGHT";
+    }
+};
+
+
+#endif //LIBCMAES_NETWORKWEIGHTS_H
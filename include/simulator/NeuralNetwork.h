@@ -10,69 +10,163 @@
 #include <cmath>
 #include <iostream>
 #include <utility>
+#include <algorithm>
+#include <memory>
+#include <Eigen/Dense>
 
 using Features = std::vector<float>;
 
 class NeuralNetwork {
 
 public:
-    explicit NeuralNetwork(std::vector<std::vector<std::vector<float>>> weights) : weights(std::move(weights)) {};
+    using LayerParameters = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using LayerWeights = Eigen::Map<const LayerParameters>;
+    using LayerBiases = Eigen::Map<const Eigen::RowVectorXf>;
+    using Activations = Eigen::VectorXf;
+    using BatchInputs = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using BatchActivations = Eigen::MatrixXf;
+
+    // weights[layer][previousNeuron][neuron], the last previousNeuron row of every layer holding the biases
+    explicit NeuralNetwork(const std::vector<std::vector<std::vector<float>>> &weights) {
+        std::vector<int> nodesInLayersCount;
+        auto parameters = std::make_shared<std::vector<float>>();
+        for (const auto &layer: weights) {
+            if (nodesInLayersCount.empty())
+                nodesInLayersCount.push_back(int(layer.size()) - 1);
+            nodesInLayersCount.push_back(int(layer[0].size()));
+            for (const auto &previousNeuron: layer)
+                parameters->insert(parameters->end(), previousNeuron.begin(), previousNeuron.end());
+        }
+        storage = parameters;
+        mapLayers(nodesInLayersCount, storage->data());
+    };
 
-    std::vector<float> simulate(std::vector<float> inputs) {
-        int layersCount = getLayersCount();
-        std::vector<float> previousLayerNeurons = inputs;
+    // view over parameters laid out as a CMA-ES candidate: layer by layer, [previousNeuron][neuron] with the biases
+    // as last previousNeuron row. No copy is made, parameters must outlive the network and all its copies
+    NeuralNetwork(const std::vector<int> &nodesInLayersCount, const float *parameters) {
+        mapLayers(nodesInLayersCount, parameters);
+    }
 
+    // network over a candidate converted to float once, copies share the converted parameters read-only
+    NeuralNetwork(const std::vector<int> &nodesInLayersCount, const double *x) {
+        auto parameters = std::make_shared<std::vector<float>>(parametersNumber(nodesInLayersCount));
+        std::copy(x, x + parameters->size(), parameters->begin());
+        storage = parameters;
+        mapLayers(nodesInLayersCount, storage->data());
+    }
 
-        for (int layerIndex = 1; layerIndex < layersCount; layerIndex++) {
-            std::vector<float> layerNeurons;
-            int neuronsCount = getLayerSize(layerIndex);
+    static size_t parametersNumber(const std::vector<int> &nodesInLayersCount) {
+        size_t result = 0;
+        for (size_t layer = 0; layer + 1 < nodesInLayersCount.size(); layer++)
+            result += size_t(nodesInLayersCount[layer] + 1) * size_t(nodesInLayersCount[layer + 1]);
+        return result;
+    }
 
-            for (int neuronIndex = 0; neuronIndex < neuronsCount; neuronIndex++) {
-                float neuron = calculateNeuron(layerIndex, neuronIndex, previousLayerNeurons);
-                layerNeurons.push_back(neuron);
-            }
+    // forward pass over a contiguous input of getInputSize() values, returns the preallocated output layer
+    const Activations &forward(const float *inputs) {
+        auto layersCount = layerWeights.size();
+        Eigen::Map<const Activations> input(inputs, getInputSize());
 
-            previousLayerNeurons = layerNeurons;
+        activations[0].noalias() = layerWeights[0].transpose() * input;
+        activate(0);
+        for (size_t layer = 1; layer < layersCount; layer++) {
+            activations[layer].noalias() = layerWeights[layer].transpose() * activations[layer - 1];
+            activate(layer);
         }
 
-        return previousLayerNeurons;
-    };
-private:
-    std::vector<std::vector<std::vector<float>>> weights;
+        return activations.back();
+    }
+
+    // forward pass over the first rows of inputs, one sample per row, as one matrix-matrix product per layer.
+    // Columns of inputs beyond getInputSize() are ignored. Returns the first output of every row, valid until the next call.
+    const float *rateBatch(const BatchInputs &inputs, long rows) {
+        auto layersCount = layerWeights.size();
+        if (batchActivations.empty() || batchActivations[0].rows() < rows) {
+            long capacity = std::max(rows, 2 * batchCapacity()); // before clear(), which empties batchCapacity()
+            batchActivations.clear();
+            for (const auto &w: layerWeights)
+                batchActivations.emplace_back(capacity, w.cols());
+        }
+
+        batchActivations[0].topRows(rows).noalias() =
+                inputs.topLeftCorner(rows, getInputSize()) * layerWeights[0];
+        activateBatch(0, rows);
+        for (size_t layer = 1; layer < layersCount; layer++) {
+            batchActivations[layer].topRows(rows).noalias() =
+                    batchActivations[layer - 1].topRows(rows) * layerWeights[layer];
+            activateBatch(layer, rows);
+        }
 
-    static float calculateSigm(float value) {
-        return 1 / (1 + std::exp(-value));
+        return batchActivations.back().data(); //first output column
     }
 
-    float calculateNeuron(int layerIndex, int neuronIndex, std::vector<float> previousLayerNeurons) {
-        int previousLayerIndex = layerIndex - 1;
-        int previousLayerNeuronsCount = previousLayerNeurons.size();
-        float value = 0;
+    // index of the first best rated row of inputs
+    long selectBest(const BatchInputs &inputs, long rows) {
+        return selectBest(rateBatch(inputs, rows), rows);
+    }
 
-        for (int previousLayerNeuronIndex = 0;
-             previousLayerNeuronIndex < previousLayerNeuronsCount; previousLayerNeuronIndex++) {
-            float weight = weights[previousLayerIndex][previousLayerNeuronIndex][neuronIndex];
-            float neuron = previousLayerNeurons[previousLayerNeuronIndex];
+    // index of the first best of ratings
+    static long selectBest(const float *ratings, long rows) {
+        long best = 0;
+        for (long row = 1; row < rows; row++)
+            if (ratings[row] > ratings[best])
+                best = row;
+        return best;
+    }
 
-            value += weight * neuron;
-        }
+    float rate(const Features &inputs) {
+        return forward(inputs.data())(0);
+    }
 
-        // Add bias
-        value += weights[previousLayerIndex][previousLayerNeuronsCount][neuronIndex];
+    std::vector<float> simulate(const std::vector<float> &inputs) {
+        const Activations &output = forward(inputs.data());
+        return std::vector<float>(output.data(), output.data() + output.size());
+    };
 
-        return calculateSigm(value);
+    long getInputSize() const {
+        return layerWeights[0].rows();
     }
 
-    int getLayerSize(int index) {
-        if (index == 0) {
-            return weights[index].size() - 1;
+    long getOutputSize() const {
+        return layerWeights.back().cols();
+    }
+
+private:
+    std::shared_ptr<const std::vector<float>> storage; //parameters owned by the network, shared by its copies
+    std::vector<LayerWeights> layerWeights; //previous neurons by neurons, over storage or the caller's buffer
+    std::vector<LayerBiases> layerBiases; //row following the weights of every layer
+    std::vector<Activations> activations; //one preallocated buffer per layer, so no allocation happens in forward()
+    std::vector<BatchActivations> batchActivations; //same for selectBest(), grown on demand
+
+    long batchCapacity() const {
+        return batchActivations.empty() ? 0 : batchActivations[0].rows();
+    }
+
+    void mapLayers(const std::vector<int> &nodesInLayersCount, const float *parameters) {
+        auto layersCount = nodesInLayersCount.size() - 1;
+        layerWeights.reserve(layersCount);
+        layerBiases.reserve(layersCount);
+        activations.reserve(layersCount);
+
+        for (size_t layer = 0; layer < layersCount; layer++) {
+            long previousNeuronsCount = nodesInLayersCount[layer];
+            long neuronsCount = nodesInLayersCount[layer + 1];
+            layerWeights.emplace_back(parameters, previousNeuronsCount, neuronsCount);
+            layerBiases.emplace_back(parameters + previousNeuronsCount * neuronsCount, neuronsCount);
+            activations.emplace_back(neuronsCount);
+            parameters += (previousNeuronsCount + 1) * neuronsCount;
         }
+    }
 
-        return weights[index - 1][0].size();
+    void activate(size_t layer) {
+        auto values = activations[layer].array();
+        values = (1.0f + (-(values + layerBiases[layer].transpose().array())).exp()).inverse(); //vectorized sigmoid
     }
 
-    int getLayersCount() {
-        return weights.size() + 1;
+    void activateBatch(size_t layer, long rows) {
+        auto values = batchActivations[layer].topRows(rows);
+        values.rowwise() += layerBiases[layer];
+        values.array() = (1.0f + (-values.array()).exp()).inverse();
     }
 
 };
@@ -7,15 +7,18 @@
 
 
 #include <list>
+#include <limits>
 #include "NeuralNetwork.h"
+#include "Skyline.h"
+#include "PlacementTrace.h"
 
-using LengthUnit = unsigned long;
-using CounterPoint = std::pair<LengthUnit, LengthUnit>;
 using ItemType = std::pair<LengthUnit, LengthUnit>;
 using ItemTypeTuple = std::pair<ItemType, unsigned long>;
 
 
-class Palette {
+// packs items onto a palette, trials rated by a TNetwork: a NeuralNetwork or a FixedNeuralNetwork
+template<class TNetwork>
+class BasicPalette {
 private:
     const LengthUnit width;
     const LengthUnit height;
@@ -26,264 +29,116 @@ private:
 
     unsigned long itemsNumber;
 
-    std::list<CounterPoint> counterPoints;
+    Skyline counterPoints;
     std::list<ItemTypeTuple> itemTypes; //pair of pairs is faster than tuple, see https://stackoverflow.com/questions/6687107/difference-between-stdpair-and-stdtuple-with-only-two-members
 
-    NeuralNetwork network;
+    TNetwork network;
 
-    std::pair<bool, LengthUnit> performInsertionStep() {
-        double bestRating = -1;
+    template<class TTraceSink>
+    std::pair<bool, LengthUnit> performInsertionStep(TTraceSink &trace) {
         LengthUnit bestArea = 0;
 
-        struct InsertionTrialResult bestTrialResult;
-        auto cpBeg = counterPoints.begin();
-        std::list<ItemTypeTuple>::iterator bestItemTypeIter;
+        collectInsertionTrials();
 
-        auto itemTypesEnd = itemTypes.end();
-        for (auto itemTypesIter = itemTypes.begin(); itemTypesIter != itemTypesEnd; itemTypesIter++) {
-            auto cpEnd = counterPoints.end();
-            for (auto cpIterator = counterPoints.begin();
-                 cpIterator != cpEnd; cpIterator++) { //TODO upgrade iterative search to bisection search
-                tryInsertionForItem(cpIterator, cpBeg, cpEnd, itemTypesIter, itemTypesIter->first.first,
-                                    itemTypesIter->first.second, bestRating,
-                                    bestTrialResult, bestItemTypeIter);
-                tryInsertionForItem(cpIterator, cpBeg, cpEnd, itemTypesIter, itemTypesIter->first.second,
-                                    itemTypesIter->first.first, bestRating,
-                                    bestTrialResult, bestItemTypeIter);
-            }
-        }
-
-        if (bestRating >= 0) {
-            updateCounterPoints(bestTrialResult);
-            updateItemList(bestItemTypeIter);
-            remainingArea -= bestTrialResult.area;
-            bestArea = bestTrialResult.area;
-        }
-
-        return std::pair<bool, LengthUnit>{bestRating >= 0, bestArea};
-    }
-
-    std::pair<bool, std::vector<LengthUnit>> performInsertionStepWithSave() {
-        double bestRating = -1;
-        std::vector<LengthUnit> bestItemInsertion = {};
-
-        struct ExtendedInsertionTrialResult bestTrialResult;
-        auto cpBeg = counterPoints.begin();
-        std::list<ItemTypeTuple>::iterator bestItemTypeIter;
-
-        auto itemTypesEnd = itemTypes.end();
-        for (auto itemTypesIter = itemTypes.begin(); itemTypesIter != itemTypesEnd; itemTypesIter++) {
-            auto cpEnd = counterPoints.end();
-            for (auto cpIterator = counterPoints.begin();
-                 cpIterator != cpEnd; cpIterator++) { //TODO upgrade iterative search to bisection search
-                tryInsertionForItemWithSave(cpIterator, cpBeg, cpEnd, itemTypesIter, itemTypesIter->first.first,
-                                            itemTypesIter->first.second, bestRating,
-                                            bestTrialResult, bestItemTypeIter);
-                tryInsertionForItemWithSave(cpIterator, cpBeg, cpEnd, itemTypesIter, itemTypesIter->first.second,
-                                            itemTypesIter->first.first, bestRating,
-                                            bestTrialResult, bestItemTypeIter);
-            }
-        }
-
-        if (bestRating >= 0) {
+        if (trialsNumber > 0) {
+            const InsertionTrialResult &bestTrialResult = scoreInsertionTrials();
             //todo - check pivot
-            bestItemInsertion = {bestTrialResult.rightBorder - bestTrialResult.width,
-                                 bestTrialResult.topBorder - bestTrialResult.height,
-                                 bestTrialResult.width, bestTrialResult.height};
-            updateCounterPoints(bestTrialResult);
-            updateItemList(bestItemTypeIter);
+            trace.recordPlacement(bestTrialResult.rightBorder - bestTrialResult.width,
+                                  bestTrialResult.topBorder - bestTrialResult.height,
+                                  bestTrialResult.width, bestTrialResult.height);
+            applyTrial(bestTrialResult);
+            bestArea = bestTrialResult.area;
         }
 
-
-        return std::pair<bool, std::vector<LengthUnit>>{bestRating >= 0, bestItemInsertion};
+        return std::pair<bool, LengthUnit>{trialsNumber > 0, bestArea};
     }
 
     struct InsertionTrialResult {
-        std::list<CounterPoint>::iterator topLeftCp;
-        std::list<CounterPoint>::iterator bottomRightCp;
+        long topLeftCp{};
+        long bottomRightCp{};
+        std::list<ItemTypeTuple>::iterator itemType;
         LengthUnit rightBorder{};
         LengthUnit topBorder{};
         LengthUnit area{};
-    };
-
-    struct ExtendedInsertionTrialResult : InsertionTrialResult {
         LengthUnit width{};
         LengthUnit height{};
+        LengthUnit wastedWidth{};
+        LengthUnit wastedHeight{};
+        LengthUnit wastedArea{};
+        unsigned itemTypeIndex{};
     };
 
-    void tryInsertionForItem(const std::list<CounterPoint>::iterator &cpIterator,
-                             const std::list<CounterPoint>::iterator &beg,
-                             const std::list<CounterPoint>::iterator &end,
-                             const std::list<ItemTypeTuple>::iterator &itemTypesIterator,
-                             const LengthUnit itemWidth, const LengthUnit itemHeight, double &bestRating,
-                             Palette::InsertionTrialResult &bestTrialResult,
-                             std::list<ItemTypeTuple>::iterator &bestItemTypeIterator) {
-        std::pair<bool, bool> result = {true, true};
-
-        LengthUnit topBorder = cpIterator->second + itemHeight;
-        LengthUnit rightBorder = cpIterator->first + itemWidth;
+    std::vector<InsertionTrialResult> trials; //legal trials of the current step
+    long trialsNumber = 0;
+    std::vector<long> scoredTrials; //trials rated by the network, scoredTrials[i] is described by row i of trialFeatures
+    typename TNetwork::BatchInputs trialFeatures;
 
-        if (rightBorder > width)
-            result.first = false;
+    unsigned prefilterSize = 0; //max trials rated by the network per step, 0 rates all of them
+    unsigned long legalTrialsTotal = 0;
+    unsigned long scoredTrialsTotal = 0;
 
-        if (topBorder > height)
-            result.second = false;
-        else if (result.first) { //item is legal to place
-            InsertionTrialResult trialResult;
+    // first phase of a step: geometry of every legal trial, the trials kept by the prefilter are rated at once afterwards
+    void collectInsertionTrials() {
+        trialsNumber = 0;
+        auto maxTrials = size_t(2 * itemTypes.size() * counterPoints.size());
+        if (trials.size() < maxTrials)
+            trials.resize(maxTrials);
 
-            LengthUnit totalWastedWidth = 0;
-            LengthUnit totalWastedHeight = 0;
-            LengthUnit totalWastedArea = 0;
-
-            auto topLeftCP = cpIterator;
-            while (topLeftCP != beg) {
-                auto prev = std::prev(topLeftCP);
-                if (prev->second > topBorder)
-                    break;
-
-                LengthUnit wastedWidth = topLeftCP->first - prev->first;
-                LengthUnit wastedHeight = topBorder - prev->second;
-                totalWastedWidth += wastedWidth;
-                totalWastedHeight += wastedHeight;
-                totalWastedArea += wastedWidth * wastedHeight;
-
-                topLeftCP = prev;
-            }
-
-            auto bottomRightCP = cpIterator;
-            while (true) {
-                auto next = std::next(bottomRightCP);
-                if (next == end || next->first > rightBorder)
-                    break;
-
-                LengthUnit wastedWidth = rightBorder - next->first;
-                LengthUnit wastedHeight = bottomRightCP->second - next->second;
-                totalWastedWidth += wastedWidth;
-                totalWastedHeight += wastedHeight;
-                totalWastedArea += wastedWidth * wastedHeight;
-
-                bottomRightCP = next;
-            }
-
-            trialResult.bottomRightCp = bottomRightCP;
-            trialResult.topLeftCp = topLeftCP;
-            trialResult.rightBorder = rightBorder;
-            trialResult.topBorder = topBorder;
-            LengthUnit itemArea = itemHeight * itemWidth;
-            trialResult.area = itemArea;
-
-            // TODO calculate features
-            Features features = {
-                    (float) itemWidth / (float) width,
-                    (float) itemHeight / (float) height,
-                    float(itemArea) / float(remainingArea),
-                    float(totalWastedWidth) / float(width),
-                    float(totalWastedHeight) / float(height),
-                    float(totalWastedArea) / float(remainingArea)
-            };
-
-            LengthUnit lowerBound, upperBound;
-            lowerBound = bottomRightCP->second;
-            upperBound = topBorder;
-            auto tmpIterator = std::prev(end);
-            auto lowestCpHeight = tmpIterator->second;
-            LengthUnit level = 0;
-
-            if (lowestCpHeight > 0) {
-                while (level <= lowestCpHeight) {
-                    features.emplace_back(1.0f);
-                    level += levelIncrement;
-                }
-            }
-
-            auto widthAsFloat = float(width);
-
-            if (lowerBound > 0) {
-                while (level <= lowerBound) {
-                    auto prev = std::prev(tmpIterator);
-                    while (prev != bottomRightCP && prev->second < level) {
-                        tmpIterator = prev;
-                        prev = std::prev(prev);
-                    }
-                    features.emplace_back(float(tmpIterator->first) / widthAsFloat);
-                    level += levelIncrement;
-                }
-            }
-
-            auto itemLevelValue = float(rightBorder) / widthAsFloat;
-            while (level <= upperBound) {
-                features.emplace_back(itemLevelValue);
-                level += levelIncrement;
-            }
-
-            if (topLeftCP != beg) {
-                auto firstCpHeight = beg->second;
-                tmpIterator = topLeftCP;
-                auto prev = std::prev(tmpIterator);
-
-                while (level <= firstCpHeight) {
-                    while (tmpIterator != beg && prev->second < level) {
-                        tmpIterator = prev;
-                        prev = std::prev(prev);
-                    }
-                    features.emplace_back(float(tmpIterator->first) / float(width));
-                    level += levelIncrement;
-                }
+        auto cpsNumber = counterPoints.size();
+        auto itemTypesEnd = itemTypes.end();
+        unsigned itemTypeIndex = 0;
+        for (auto itemTypesIter = itemTypes.begin(); itemTypesIter != itemTypesEnd; itemTypesIter++, itemTypeIndex++) {
+            for (long cp = 0; cp < cpsNumber; cp++) {
+                tryInsertionForItem(cp, itemTypesIter, itemTypeIndex, itemTypesIter->first.first,
+                                    itemTypesIter->first.second);
+                if (itemTypesIter->first.first != itemTypesIter->first.second) //a rotated square is the same trial
+                    tryInsertionForItem(cp, itemTypesIter, itemTypeIndex, itemTypesIter->first.second,
+                                        itemTypesIter->first.first);
             }
+        }
+    }
 
-            itemLevelValue = float(beg->first) / widthAsFloat;
-            while (level <= height) {
-                features.emplace_back(itemLevelValue);
-                level += levelIncrement;
+    Features stepFeatures; //features shared by all trials of a step, see updateStepFeatures()
+    unsigned levelsFeaturesNumber;
+    static const unsigned levelsFeaturesOffset = 6;
+    unsigned itemTypesFeaturesOffset;
+    unsigned stepFeaturesNumber; //placement dependent features follow
+
+    // height profile of the counter points and remaining item counts, trials only patch the slots they change
+    void updateStepFeatures() {
+        std::fill(stepFeatures.begin(), stepFeatures.end(), 0.0f);
+
+        auto lastCp = counterPoints.size() - 1;
+        auto lowestCpHeight = counterPoints[lastCp].second;
+        auto cp = lastCp;
+        LengthUnit level = 0;
+        for (unsigned i = 0; i < levelsFeaturesNumber; i++, level += levelIncrement) {
+            if (lowestCpHeight > 0 && level <= lowestCpHeight)
+                stepFeatures[levelsFeaturesOffset + i] = 1.0f;
+            else {
+                while (cp > 0 && counterPoints[cp - 1].second < level) //leftmost cp lower than level
+                    cp--;
+                stepFeatures[levelsFeaturesOffset + i] = float(counterPoints[cp].first) / float(width);
             }
+        }
 
-            features.emplace_back(
-                    float(std::distance(topLeftCP, bottomRightCP) + 1) / float(counterPoints.size())); //used cps amount
-
-            auto itemNumbersAsFloat = float(itemsNumber);
-            for (auto it = itemTypes.begin(); it != itemTypesIterator; it++) //how many items yet to place
-                features.emplace_back(float(it->second) / itemNumbersAsFloat);
-
-            features.emplace_back(float(itemTypesIterator->second - 1) / itemNumbersAsFloat);
-
-            auto itemTypesEnd = itemTypes.end();
-            for (auto it = std::next(itemTypesIterator); it != itemTypesEnd; it++)
-                features.emplace_back(float(it->second) / itemNumbersAsFloat);
-
-            for (auto i = itemTypes.size();
-                 i < itemTypesNumberLimit; i++)  //complete missing itemTypes to always same size
-                features.emplace_back(0.0f);
-
-            LengthUnit remainingHeight = height - topBorder; //how much space is wasted if same type would be inserted
-            features.emplace_back(float(remainingHeight % itemHeight) / float(remainingHeight));
-
-            LengthUnit remainingWidth = width - rightBorder;
-            features.emplace_back(float(remainingWidth % itemWidth) / float(remainingWidth));
-
-            features.emplace_back(rightBorder == width ? 1.0f : 0.0f); //whether the edges match
-            features.emplace_back(topBorder == height ? 1.0f : 0.0f);
-
-            auto rating = network.simulate(features);
+        auto featureIndex = itemTypesFeaturesOffset;
+        auto itemNumbersAsFloat = float(itemsNumber);
+        for (auto &itemType: itemTypes) //how many items yet to place
+            stepFeatures[featureIndex++] = float(itemType.second) / itemNumbersAsFloat;
 
-            if (rating[0] > bestRating) { //if improve
-                bestTrialResult = trialResult;
-                bestRating = rating[0];
-                bestItemTypeIterator = itemTypesIterator;
-            }
-        }
+        stepFeaturesNumber = itemTypesFeaturesOffset +
+                             unsigned(std::max<size_t>(itemTypes.size(), itemTypesNumberLimit)); //complete missing itemTypes to always same size
     }
 
-    void tryInsertionForItemWithSave(const std::list<CounterPoint>::iterator &cpIterator,
-                                     const std::list<CounterPoint>::iterator &beg,
-                                     const std::list<CounterPoint>::iterator &end,
-                                     const std::list<ItemTypeTuple>::iterator &itemTypesIterator,
-                                     const LengthUnit itemWidth, const LengthUnit itemHeight, double &bestRating,
-                                     Palette::ExtendedInsertionTrialResult &bestTrialResult,
-                                     std::list<ItemTypeTuple>::iterator &bestItemTypeIterator) {
+    void tryInsertionForItem(const long cp,
+                             const std::list<ItemTypeTuple>::iterator &itemTypesIterator, const unsigned itemTypeIndex,
+                             const LengthUnit itemWidth, const LengthUnit itemHeight) {
         std::pair<bool, bool> result = {true, true};
 
-        LengthUnit topBorder = cpIterator->second + itemHeight;
-        LengthUnit rightBorder = cpIterator->first + itemWidth;
+        const CounterPoint &cpPoint = counterPoints[cp];
+        LengthUnit topBorder = cpPoint.second + itemHeight;
+        LengthUnit rightBorder = cpPoint.first + itemWidth;
 
         if (rightBorder > width)
             result.first = false;
@@ -291,175 +146,132 @@ private:
         if (topBorder > height)
             result.second = false;
         else if (result.first) { //item is legal to place
-            ExtendedInsertionTrialResult trialResult;
+            InsertionTrialResult &trialResult = trials[trialsNumber++];
 
             LengthUnit totalWastedWidth = 0;
             LengthUnit totalWastedHeight = 0;
             LengthUnit totalWastedArea = 0;
 
-            auto topLeftCP = cpIterator;
-            while (topLeftCP != beg) {
-                auto prev = std::prev(topLeftCP);
-                if (prev->second > topBorder)
-                    break;
-
-                LengthUnit wastedWidth = topLeftCP->first - prev->first;
-                LengthUnit wastedHeight = topBorder - prev->second;
-                totalWastedWidth += wastedWidth;
-                totalWastedHeight += wastedHeight;
-                totalWastedArea += wastedWidth * wastedHeight;
-
-                topLeftCP = prev;
-            }
-
-            auto bottomRightCP = cpIterator;
-            while (true) {
-                auto next = std::next(bottomRightCP);
-                if (next == end || next->first > rightBorder)
-                    break;
+            auto topLeftCP = counterPoints.findTopLeft(cp, topBorder);
+            counterPoints.addLeftWaste(topLeftCP, cp, topBorder, totalWastedWidth, totalWastedHeight, totalWastedArea);
 
-                LengthUnit wastedWidth = rightBorder - next->first;
-                LengthUnit wastedHeight = bottomRightCP->second - next->second;
-                totalWastedWidth += wastedWidth;
-                totalWastedHeight += wastedHeight;
-                totalWastedArea += wastedWidth * wastedHeight;
-
-                bottomRightCP = next;
-            }
+            auto bottomRightCP = counterPoints.findBottomRight(cp, rightBorder);
+            counterPoints.addRightWaste(cp, bottomRightCP, rightBorder, totalWastedWidth, totalWastedHeight,
+                                        totalWastedArea);
 
             trialResult.bottomRightCp = bottomRightCP;
             trialResult.topLeftCp = topLeftCP;
+            trialResult.itemType = itemTypesIterator;
+            trialResult.itemTypeIndex = itemTypeIndex;
             trialResult.rightBorder = rightBorder;
             trialResult.topBorder = topBorder;
-            LengthUnit itemArea = itemHeight * itemWidth;
-            trialResult.area = itemArea;
+            trialResult.area = itemHeight * itemWidth;
             trialResult.width = itemWidth;
             trialResult.height = itemHeight;
+            trialResult.wastedWidth = totalWastedWidth;
+            trialResult.wastedHeight = totalWastedHeight;
+            trialResult.wastedArea = totalWastedArea;
+        }
+    }
 
-            // TODO calculate features
-            Features features = {
-                    (float) itemWidth / (float) width,
-                    (float) itemHeight / (float) height,
-                    float(itemArea) / float(remainingArea),
-                    float(totalWastedWidth) / float(width),
-                    float(totalWastedHeight) / float(height),
-                    float(totalWastedArea) / float(remainingArea)
-            };
-
-            LengthUnit lowerBound, upperBound;
-            lowerBound = bottomRightCP->second;
-            upperBound = topBorder;
-            auto tmpIterator = std::prev(end);
-            auto lowestCpHeight = tmpIterator->second;
-            LengthUnit level = 0;
-
-            if (lowestCpHeight > 0) {
-                while (level <= lowestCpHeight) {
-                    features.emplace_back(1.0f);
-                    level += levelIncrement;
-                }
-            }
+    // cheap rating of a trial for the prefilter, lower is better: wasted area relative to the item, minus aligned edges
+    float prefilterCost(const InsertionTrialResult &trial) const {
+        unsigned alignedEdges = (trial.rightBorder == width) + (trial.topBorder == height);
+        if (trial.topLeftCp > 0 && counterPoints[trial.topLeftCp - 1].second == trial.topBorder)
+            alignedEdges++;
+        if (trial.bottomRightCp + 1 < counterPoints.size() &&
+            counterPoints[trial.bottomRightCp + 1].first == trial.rightBorder)
+            alignedEdges++;
+        return float(trial.wastedArea) / float(trial.area) - prefilterEdgeWeight * float(alignedEdges);
+    }
 
-            auto widthAsFloat = float(width);
-
-            if (lowerBound > 0) {
-                while (level <= lowerBound) {
-                    auto prev = std::prev(tmpIterator);
-                    while (prev != bottomRightCP && prev->second < level) {
-                        tmpIterator = prev;
-                        prev = std::prev(prev);
-                    }
-                    features.emplace_back(float(tmpIterator->first) / widthAsFloat);
-                    level += levelIncrement;
-                }
-            }
+    static constexpr float prefilterEdgeWeight = 0.1f;
 
-            auto itemLevelValue = float(rightBorder) / widthAsFloat;
-            while (level <= upperBound) {
-                features.emplace_back(itemLevelValue);
-                level += levelIncrement;
-            }
+    // second phase of a step: features of the trials kept by the prefilter, rated by the network in one batch
+    const InsertionTrialResult &scoreInsertionTrials() {
+        auto rows = prepareScoredTrials();
+        if (trialFeatures.rows() < rows)
+            trialFeatures.resize(rows, trialFeatures.cols());
+        writeScoredTrials(trialFeatures, 0);
 
-            if (topLeftCP != beg) {
-                auto firstCpHeight = beg->second;
-                tmpIterator = topLeftCP;
-                auto prev = std::prev(tmpIterator);
-
-                while (level <= firstCpHeight) {
-                    while (tmpIterator != beg && prev->second < level) {
-                        tmpIterator = prev;
-                        prev = std::prev(prev);
-                    }
-                    features.emplace_back(float(tmpIterator->first) / float(width));
-                    level += levelIncrement;
-                }
-            }
+        return trials[scoredTrials[network.selectBest(trialFeatures, rows)]];
+    }
 
-            itemLevelValue = float(beg->first) / widthAsFloat;
-            while (level <= height) {
-                features.emplace_back(itemLevelValue);
-                level += levelIncrement;
-            }
+    // prefilter of the collected trials and features shared by the step, returns how many trials the network rates
+    long prepareScoredTrials() {
+        scoredTrials.resize(trialsNumber);
+        for (long i = 0; i < trialsNumber; i++)
+            scoredTrials[i] = i;
+
+        if (prefilterSize > 0 && trialsNumber > prefilterSize) {
+            std::vector<float> costs(trialsNumber);
+            for (long i = 0; i < trialsNumber; i++)
+                costs[i] = prefilterCost(trials[i]);
+            std::nth_element(scoredTrials.begin(), scoredTrials.begin() + prefilterSize, scoredTrials.end(),
+                             [&costs](long a, long b) { return costs[a] < costs[b] || (costs[a] == costs[b] && a < b); });
+            scoredTrials.resize(prefilterSize);
+            std::sort(scoredTrials.begin(), scoredTrials.end()); //back to trial order, the first best trial wins
+        }
 
-            features.emplace_back(
-                    float(std::distance(topLeftCP, bottomRightCP) + 1) / float(counterPoints.size())); //used cps amount
+        legalTrialsTotal += trialsNumber;
+        scoredTrialsTotal += scoredTrials.size();
 
-            auto itemNumbersAsFloat = float(itemsNumber);
-            for (auto it = itemTypes.begin(); it != itemTypesIterator; it++) //how many items yet to place
-                features.emplace_back(float(it->second) / itemNumbersAsFloat);
+        updateStepFeatures();
+        return long(scoredTrials.size());
+    }
 
-            features.emplace_back(float(itemTypesIterator->second - 1) / itemNumbersAsFloat);
+    // features of the scored trials into rows [firstRow, firstRow + scoredTrials.size()) of features
+    void writeScoredTrials(typename TNetwork::BatchInputs &features, long firstRow) {
+        for (size_t row = 0; row < scoredTrials.size(); row++)
+            writeTrialFeatures(trials[scoredTrials[row]], features.row(firstRow + long(row)).data());
+    }
 
-            auto itemTypesEnd = itemTypes.end();
-            for (auto it = std::next(itemTypesIterator); it != itemTypesEnd; it++)
-                features.emplace_back(float(it->second) / itemNumbersAsFloat);
+    void writeTrialFeatures(const InsertionTrialResult &trial, float *features) {
+        std::copy(stepFeatures.begin(), stepFeatures.end(), features);
+        unsigned featureIndex = 0;
 
-            for (auto i = itemTypes.size();
-                 i < itemTypesNumberLimit; i++)  //complete missing itemTypes to always same size
-                features.emplace_back(0.0f);
+        auto itemWidth = trial.width;
+        auto itemHeight = trial.height;
+        auto rightBorder = trial.rightBorder;
+        auto topBorder = trial.topBorder;
 
-            LengthUnit remainingHeight = height - topBorder; //how much space is wasted if same type would be inserted
-            features.emplace_back(float(remainingHeight % itemHeight) / float(remainingHeight));
+        // TODO calculate features
+        features[featureIndex++] = (float) itemWidth / (float) width;
+        features[featureIndex++] = (float) itemHeight / (float) height;
+        features[featureIndex++] = float(trial.area) / float(remainingArea);
+        features[featureIndex++] = float(trial.wastedWidth) / float(width);
+        features[featureIndex++] = float(trial.wastedHeight) / float(height);
+        features[featureIndex++] = float(trial.wastedArea) / float(remainingArea);
 
-            LengthUnit remainingWidth = width - rightBorder;
-            features.emplace_back(float(remainingWidth % itemWidth) / float(remainingWidth));
+        //levels between the bottom right cp and the item's top border see the item, the others keep the step profile
+        auto lowerBound = counterPoints[trial.bottomRightCp].second;
+        auto itemLevelValue = float(rightBorder) / float(width);
+        auto lastItemLevel = levelsFeaturesOffset + topBorder / levelIncrement;
+        for (auto level = levelsFeaturesOffset + (lowerBound > 0 ? lowerBound / levelIncrement + 1 : 0);
+             level <= lastItemLevel; level++)
+            features[level] = itemLevelValue;
 
-            features.emplace_back(rightBorder == width ? 1.0f : 0.0f); //whether the edges match
-            features.emplace_back(topBorder == height ? 1.0f : 0.0f);
+        features[levelsFeaturesOffset + levelsFeaturesNumber] =
+                float(trial.bottomRightCp - trial.topLeftCp + 1) / float(counterPoints.size()); //used cps amount
 
-            auto rating = network.simulate(features);
+        features[itemTypesFeaturesOffset + trial.itemTypeIndex] =
+                float(trial.itemType->second - 1) / float(itemsNumber); //this item is placed
 
-            if (rating[0] > bestRating) { //if improve
-                bestTrialResult = trialResult;
-                bestRating = rating[0];
-                bestItemTypeIterator = itemTypesIterator;
-            }
-        }
-    }
+        featureIndex = stepFeaturesNumber;
 
-    void updateCounterPoints(const Palette::InsertionTrialResult &bestTrialResult) {
-        auto bottomRightCp = bestTrialResult.bottomRightCp;
-        auto topLeftCp = bestTrialResult.topLeftCp; //TODO think whether there is simpler approach
-
-        auto topBorder = bestTrialResult.topBorder;
-        auto rightBorder = bestTrialResult.rightBorder;
-
-        if (topLeftCp == bottomRightCp) {
-            if (topBorder != height)
-                counterPoints.emplace(bottomRightCp, topLeftCp->first,
-                                      topBorder); //topleft == bottomright, so there is new topleft to add before bottomright
-        } else {
-            counterPoints.erase(std::next(topLeftCp),
-                                bottomRightCp); //remove unnecessary counterpoints in range [topleft + 1, bottomright)
-            if (topBorder == height)
-                counterPoints.pop_front();
-            else topLeftCp->second = topBorder;
-        }
+        LengthUnit remainingHeight = height - topBorder; //how much space is wasted if same type would be inserted
+        features[featureIndex++] = float(remainingHeight % itemHeight) / float(remainingHeight);
+
+        LengthUnit remainingWidth = width - rightBorder;
+        features[featureIndex++] = float(remainingWidth % itemWidth) / float(remainingWidth);
 
-        //remove last cp if it's placed at right border
-        if (rightBorder == width)
-            counterPoints.pop_back();
-        else bottomRightCp->first = rightBorder;
+        features[featureIndex++] = rightBorder == width ? 1.0f : 0.0f; //whether the edges match
+        features[featureIndex] = topBorder == height ? 1.0f : 0.0f;
+    }
+
+    void updateCounterPoints(const InsertionTrialResult &bestTrialResult) {
+        counterPoints.place(bestTrialResult.topLeftCp, bestTrialResult.bottomRightCp, bestTrialResult.rightBorder,
+                            bestTrialResult.topBorder, width, height);
     }
 
     void updateItemList(const std::list<ItemTypeTuple>::iterator &bestItemTypeIterator) {
@@ -469,76 +281,124 @@ private:
         itemsNumber--;
     }
 
+    void applyTrial(const InsertionTrialResult &trial) {
+        updateCounterPoints(trial);
+        updateItemList(trial.itemType);
+        remainingArea -= trial.area;
+    }
+
+    bool isPacking() const {
+        return !itemTypes.empty() && !counterPoints.empty();
+    }
+
+    // best fill ratio still reachable: placed area plus the remaining items that fit in the free area
+    double fillRatioBound(LengthUnit placedArea) const {
+        LengthUnit minSide = height;
+        for (auto &itemType: itemTypes)
+            minSide = std::min(minSide, std::min(itemType.first.first, itemType.first.second));
+        LengthUnit reachableArea = std::min(itemsTotalArea - placedArea, counterPoints.freeArea(width, height, minSide));
+        return double(placedArea + reachableArea) / double(itemsTotalArea);
+    }
+
+    template<class> friend class BasicPaletteBatch;
+
 public:
     static const unsigned itemTypesNumberLimit = 20;
 
 
-    Palette(const LengthUnit width, const LengthUnit height,
-            const std::list<std::pair<ItemType, unsigned long>> &itemTypes,
-            const std::vector<std::vector<std::vector<float>>> &weights, unsigned levelsNumber) : width(width),
-                                                                                                  height(height),
-                                                                                                  remainingArea(
-                                                                                                          width *
-                                                                                                          height),
-                                                                                                  levelIncrement(
-                                                                                                          height /
-                                                                                                          (levelsNumber -
-                                                                                                           1)),
-                                                                                                  itemTypes(itemTypes),
-                                                                                                  network(NeuralNetwork(
-                                                                                                          weights)) {
-        counterPoints.emplace_back(0, 0);
+    BasicPalette(const LengthUnit width, const LengthUnit height,
+                 const std::list<std::pair<ItemType, unsigned long>> &itemTypes,
+                 const std::vector<std::vector<std::vector<float>>> &weights, unsigned levelsNumber) : BasicPalette(
+            width, height, itemTypes, TNetwork(weights), levelsNumber) {}
+
+    // network shares its parameters with the given one, e.g. a view over a CMA-ES candidate
+    BasicPalette(const LengthUnit width, const LengthUnit height,
+                 const std::list<std::pair<ItemType, unsigned long>> &itemTypes,
+                 const TNetwork &network, unsigned levelsNumber) : width(width),
+                                                                   height(height),
+                                                                   remainingArea(width * height),
+                                                                   levelIncrement(height / (levelsNumber - 1)),
+                                                                   itemTypes(itemTypes),
+                                                                   network(network) {
         itemsNumber = 0;
         itemsTotalArea = 0;
         for (auto &itemType: itemTypes) {
             itemsNumber += itemType.second;
             itemsTotalArea += itemType.first.first * itemType.first.second * itemType.second;
         }
+
+        //features written by tryInsertionForItem, the network only reads the first network.getInputSize() of them
+        levelsFeaturesNumber = unsigned(height / levelIncrement + 1);
+        itemTypesFeaturesOffset = levelsFeaturesOffset + levelsFeaturesNumber + 1;
+        auto featuresNumber = long(itemTypesFeaturesOffset + std::max<size_t>(itemTypes.size(), itemTypesNumberLimit) + 4);
+        trialFeatures.resize(0, std::max(featuresNumber, network.getInputSize()));
+        stepFeatures.resize(trialFeatures.cols());
     }
 
-    double performSimulation() {
-        LengthUnit totalArea = 0;
-//        double meanResult = 0.0;
-//        unsigned long insertsNumber = 0;
+    // rates only the size trials of a step with the least wasted area and most aligned edges, 0 rates all trials
+    void setPrefilter(unsigned size) {
+        prefilterSize = size;
+    }
 
-        while (!itemTypes.empty() && !counterPoints.empty()) {
-            auto result = performInsertionStep();
-            if (!result.first)
-                break;
-            totalArea += result.second;
-        }
+    // legal trials met so far and how many of them the network rated
+    std::pair<unsigned long, unsigned long> getPrefilterStats() const {
+        return {legalTrialsTotal, scoredTrialsTotal};
+    }
 
-        if (totalArea == 0)
-            return -100;
-        else return double(totalArea) / double(itemsTotalArea);
+    double performSimulation() {
+        return performSimulation(-std::numeric_limits<double>::infinity()).second;
     }
 
-    double performSimulationWithSaveToFile(const std::string &filepath) {
+    // stops as soon as the fill ratio cannot reach cutoff anymore, e.g. the mu-th best fitness of a generation.
+    // Returns whether the simulation ran to its end and the fill ratio reached, partial when it stopped early
+    std::pair<bool, double> performSimulation(double cutoff) {
+        NullTraceSink trace;
+        return performSimulation(cutoff, trace);
+    }
+
+    // same simulation reporting the palette, every placement and the result to trace, see PlacementTrace.h
+    template<class TTraceSink>
+    std::pair<bool, double> performSimulation(double cutoff, TTraceSink &trace) {
         LengthUnit totalArea = 0;
-        std::ofstream outputFile(filepath);
-        outputFile << width << "," << height << std::endl;
+        trace.recordPalette(width, height);
 
-        while (!itemTypes.empty() && !counterPoints.empty()) {
-            auto result = performInsertionStepWithSave();
-            if (!result.first)
+        std::pair<bool, double> result{true, 0.0};
+        while (isPacking()) {
+            if (fillRatioBound(totalArea) < cutoff) {
+                result.first = false;
                 break;
-            totalArea += result.second[2] * result.second[3];
-
-            std::string cpInsertion;
-            for (auto value: result.second)
-                cpInsertion += std::to_string(value) + ",";
-            if (!cpInsertion.empty()) {
-                cpInsertion = cpInsertion.substr(0, cpInsertion.size() - 1);
-                outputFile << cpInsertion << std::endl;
             }
+            auto step = performInsertionStep(trace);
+            if (!step.first)
+                break;
+            totalArea += step.second;
         }
-        double result = double(totalArea) / double(itemsTotalArea);
-        outputFile << double(totalArea) / double(itemsTotalArea) << std::endl;
 
-        outputFile.close();
+        if (result.first && totalArea == 0)
+            result.second = -100;
+        else result.second = double(totalArea) / double(itemsTotalArea);
+        trace.recordResult(result.second);
         return result;
     }
+
+    // binary trace of the simulation, convertPlacementTraceToCsv() gives back the former text format
+    double performSimulationWithSaveToFile(const std::string &filepath) {
+        PlacementTraceWriter writer(filepath);
+        BinaryTraceSink trace(writer);
+        return performSimulation(-std::numeric_limits<double>::infinity(), trace).second;
+    }
 };
 
+template<class TNetwork>
+const unsigned BasicPalette<TNetwork>::levelsFeaturesOffset;
+
+template<class TNetwork>
+constexpr float BasicPalette<TNetwork>::prefilterEdgeWeight;
+
+template<class TNetwork>
+const unsigned BasicPalette<TNetwork>::itemTypesNumberLimit;
+
+using Palette = BasicPalette<NeuralNetwork>;
+
 
 #endif //LIBCMAES_PALETTE_H
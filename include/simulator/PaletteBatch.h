@@ -0,0 +1,177 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#ifndef LIBCMAES_PALETTEBATCH_H
+#define LIBCMAES_PALETTEBATCH_H
+
+
+#include <vector>
+#include <list>
+#include <limits>
+#include "Palette.h"
+
+// palettes packed with the same network in lock-step on one thread: every step collects the trials of the palettes
+// still packing, writes their features into one matrix and rates them with a single forward pass per group.
+// Palettes retire as soon as they run out of items, counter points or legal trials.
+// Every result equals the one of Palette::performSimulation() on the same instance.
+template<class TNetwork>
+class BasicPaletteBatch {
+public:
+    BasicPaletteBatch(const std::vector<std::vector<std::vector<float>>> &weights, unsigned levelsNumber)
+            : BasicPaletteBatch(TNetwork(weights), levelsNumber) {}
+
+    // all palettes share the parameters of network
+    BasicPaletteBatch(const TNetwork &network, unsigned levelsNumber) : network(network), levelsNumber(levelsNumber) {}
+
+    void add(const LengthUnit width, const LengthUnit height, const std::list<ItemTypeTuple> &itemTypes) {
+        palettes.emplace_back(width, height, itemTypes, network, levelsNumber);
+        featuresNumber = std::max(featuresNumber, long(palettes.back().stepFeatures.size()));
+    }
+
+    // every palette rates at most size trials per step, see Palette::setPrefilter()
+    void setPrefilter(unsigned size) {
+        for (auto &palette: palettes)
+            palette.setPrefilter(size);
+    }
+
+    size_t size() const {
+        return palettes.size();
+    }
+
+    // fill ratio of every added palette, in order of addition
+    const std::vector<double> &performSimulation() {
+        simulate(-std::numeric_limits<double>::infinity());
+        return results;
+    }
+
+    // stops all palettes as soon as their mean fill ratio cannot reach cutoff anymore, see Palette::performSimulation().
+    // Returns whether the simulation ran to its end and the mean fill ratio, partial when it stopped early
+    std::pair<bool, double> performMeanSimulation(double cutoff) {
+        bool completed = simulate(cutoff);
+        double mean = 0.0;
+        for (double result: results)
+            mean += result;
+        return {completed, mean / double(results.size())};
+    }
+
+private:
+    using Palette = BasicPalette<TNetwork>;
+
+    // trials rated per forward pass, palettes are grouped until their trials reach it so that the state of a group
+    // stays in cache between collecting, rating and placing
+    static const long groupRowsLimit = 1024;
+
+    // runs until every palette retires or the mean of their fill ratio bounds falls below meanCutoff,
+    // results then hold the final fill ratios or, when it stopped early, the partial ones
+    bool simulate(double meanCutoff) {
+        auto palettesNumber = palettes.size();
+        placedArea.assign(palettesNumber, 0);
+        bounds.resize(palettesNumber);
+        results.resize(palettesNumber);
+
+        active.clear();
+        for (size_t i = 0; i < palettesNumber; i++) {
+            if (palettes[i].isPacking()) {
+                active.push_back(i);
+                bounds[i] = palettes[i].fillRatioBound(0);
+            } else bounds[i] = resultOf(i);
+        }
+        firstRows.resize(palettesNumber);
+
+        bool completed = true;
+        while (!active.empty()) {
+            double boundsSum = 0.0;
+            for (double bound: bounds)
+                boundsSum += bound;
+            if (boundsSum < meanCutoff * double(palettesNumber)) {
+                completed = false;
+                break;
+            }
+
+            size_t stillPacking = 0;
+            size_t groupBegin = 0;
+            long rows = 0;
+            for (size_t a = 0; a < active.size(); a++) {
+                Palette &palette = palettes[active[a]];
+                palette.collectInsertionTrials();
+                if (palette.trialsNumber > 0) {
+                    firstRows[a] = rows;
+                    rows += palette.prepareScoredTrials();
+                } else firstRows[a] = -1; //no legal trial left
+
+                if (rows >= groupRowsLimit || a + 1 == active.size()) {
+                    stillPacking = performGroupStep(groupBegin, a + 1, rows, stillPacking);
+                    groupBegin = a + 1;
+                    rows = 0;
+                }
+            }
+            active.resize(stillPacking);
+        }
+
+        for (size_t i = 0; i < palettesNumber; i++)
+            results[i] = completed ? resultOf(i) : double(placedArea[i]) / double(palettes[i].itemsTotalArea);
+        return completed;
+    }
+
+    double resultOf(size_t i) const {
+        return placedArea[i] == 0 ? -100 : double(placedArea[i]) / double(palettes[i].itemsTotalArea);
+    }
+
+    // rates the trials of active palettes [begin, end) together and places the best one of every palette,
+    // palettes still packing are moved to the front of active from position stillPacking on, returns the new end
+    size_t performGroupStep(size_t begin, size_t end, long rows, size_t stillPacking) {
+        if (rows > 0) {
+            if (features.rows() < rows || features.cols() < featuresNumber)
+                features.resize(std::max(rows, 2 * features.rows()), featuresNumber);
+            for (size_t a = begin; a < end; a++)
+                if (firstRows[a] >= 0)
+                    palettes[active[a]].writeScoredTrials(features, firstRows[a]);
+            ratings = network.rateBatch(features, rows);
+        }
+
+        for (size_t a = begin; a < end; a++) {
+            auto i = active[a];
+            Palette &palette = palettes[i];
+            if (firstRows[a] < 0) { //retired
+                bounds[i] = resultOf(i);
+                continue;
+            }
+
+            auto scored = long(palette.scoredTrials.size());
+            const typename Palette::InsertionTrialResult &bestTrial =
+                    palette.trials[palette.scoredTrials[NeuralNetwork::selectBest(ratings + firstRows[a], scored)]];
+            placedArea[i] += bestTrial.area;
+            palette.applyTrial(bestTrial);
+            if (palette.isPacking()) {
+                active[stillPacking++] = i;
+                bounds[i] = palette.fillRatioBound(placedArea[i]);
+            } else bounds[i] = resultOf(i);
+        }
+        return stillPacking;
+    }
+
+    TNetwork network;
+    const unsigned levelsNumber;
+
+    std::vector<Palette> palettes;
+
+    // state of the batch as parallel arrays, indexed by palette or, for firstRows, by position in active
+    std::vector<size_t> active; //palettes still packing
+    std::vector<long> firstRows; //first row of every active palette's trials in features, -1 when it retires
+    std::vector<LengthUnit> placedArea;
+    std::vector<double> bounds; //best fill ratio still reachable
+    std::vector<double> results;
+
+    typename TNetwork::BatchInputs features; //trials of a group of active palettes, one per row
+    const float *ratings = nullptr;
+    long featuresNumber = 0;
+};
+
+template<class TNetwork>
+const long BasicPaletteBatch<TNetwork>::groupRowsLimit;
+
+using PaletteBatch = BasicPaletteBatch<NeuralNetwork>;
+
+
+#endif //LIBCMAES_PALETTEBATCH_H
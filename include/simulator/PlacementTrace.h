@@ -0,0 +1,182 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#ifndef LIBCMAES_PLACEMENTTRACE_H
+#define LIBCMAES_PLACEMENTTRACE_H
+
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Binary trace of simulations, in host byte order: TraceHeader, then TraceRecords.
+// Every simulation is a palette record, its placements in order and a result record.
+
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+enum TraceRecordKind : uint64_t {
+    tracePalette = 1, //width, height
+    tracePlacement = 2, //x, y, width, height of the placed item
+    traceResult = 3 //fill ratio as the bits of a double
+};
+
+struct TraceRecord {
+    uint64_t kind;
+    uint64_t values[4];
+};
+
+static const char traceMagic[8] = {'P', 'B', 'A', 'D', 'T', 'R', 'C', 'E'};
+static const uint32_t traceVersion = 1;
+
+// buffers records and writes full buffers on its own thread, so a simulation only copies records.
+// One simulation thread per writer
+class PlacementTraceWriter {
+public:
+    explicit PlacementTraceWriter(const std::string &path) : output(path, std::ios::binary) {
+        if (!output)
+            throw std::runtime_error("cannot write placement trace " + path);
+        TraceHeader header{};
+        std::memcpy(header.magic, traceMagic, sizeof(traceMagic));
+        header.version = traceVersion;
+        output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        pending.reserve(bufferRecords);
+        writing.reserve(bufferRecords);
+        writer = std::thread(&PlacementTraceWriter::run, this);
+    }
+
+    PlacementTraceWriter(const PlacementTraceWriter &) = delete;
+
+    PlacementTraceWriter &operator=(const PlacementTraceWriter &) = delete;
+
+    ~PlacementTraceWriter() {
+        handOver();
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        changed.notify_all();
+        writer.join();
+    }
+
+    void write(const TraceRecord &record) {
+        pending.push_back(record);
+        if (pending.size() == bufferRecords)
+            handOver();
+    }
+
+private:
+    static const size_t bufferRecords = 4096;
+
+    std::ofstream output;
+    std::vector<TraceRecord> pending; //filled by the simulation
+    std::vector<TraceRecord> writing; //written by the writer thread, empty when it is idle
+    bool stopping = false;
+    std::mutex mtx;
+    std::condition_variable changed;
+    std::thread writer;
+
+    // waits for the previous buffer to be written, then passes the pending one
+    void handOver() {
+        if (pending.empty())
+            return;
+        std::unique_lock<std::mutex> lock(mtx);
+        changed.wait(lock, [this] { return writing.empty(); });
+        std::swap(pending, writing);
+        lock.unlock();
+        changed.notify_all();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            changed.wait(lock, [this] { return stopping || !writing.empty(); });
+            if (writing.empty()) //stopping
+                break;
+            lock.unlock();
+            output.write(reinterpret_cast<const char *>(writing.data()),
+                         std::streamsize(writing.size() * sizeof(TraceRecord)));
+            lock.lock();
+            writing.clear();
+            changed.notify_all();
+        }
+        output.flush();
+    }
+};
+
+// sinks receive the events of Palette::performSimulation(), NullTraceSink compiles away
+struct NullTraceSink {
+    void recordPalette(uint64_t, uint64_t) {}
+
+    void recordPlacement(uint64_t, uint64_t, uint64_t, uint64_t) {}
+
+    void recordResult(double) {}
+};
+
+class BinaryTraceSink {
+public:
+    explicit BinaryTraceSink(PlacementTraceWriter &writer) : writer(writer) {}
+
+    void recordPalette(uint64_t width, uint64_t height) {
+        writer.write({tracePalette, {width, height, 0, 0}});
+    }
+
+    void recordPlacement(uint64_t x, uint64_t y, uint64_t width, uint64_t height) {
+        writer.write({tracePlacement, {x, y, width, height}});
+    }
+
+    void recordResult(double result) {
+        uint64_t bits;
+        std::memcpy(&bits, &result, sizeof(bits));
+        writer.write({traceResult, {bits, 0, 0, 0}});
+    }
+
+private:
+    PlacementTraceWriter &writer;
+};
+
+// writes a trace in the legacy text format of performSimulationWithSaveToFile(), one block per simulation:
+// "width,height", then "x,y,width,height" per placement, then the fill ratio
+inline void convertPlacementTraceToCsv(const std::string &tracePath, std::ostream &csv) {
+    std::ifstream input(tracePath, std::ios::binary);
+    TraceHeader header{};
+    if (!input.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, traceMagic, sizeof(traceMagic)) != 0 || header.version != traceVersion)
+        throw std::runtime_error("not a placement trace " + tracePath);
+
+    TraceRecord record{};
+    while (input.read(reinterpret_cast<char *>(&record), sizeof(record))) {
+        switch (record.kind) {
+            case tracePalette:
+                csv << record.values[0] << "," << record.values[1] << "\n";
+                break;
+            case tracePlacement:
+                csv << record.values[0] << "," << record.values[1] << "," << record.values[2] << ","
+                    << record.values[3] << "\n";
+                break;
+            case traceResult: {
+                double result;
+                std::memcpy(&result, &record.values[0], sizeof(result));
+                csv << result << "\n";
+                break;
+            }
+            default:
+                throw std::runtime_error("corrupted placement trace " + tracePath);
+        }
+    }
+}
+
+
+#endif //LIBCMAES_PLACEMENTTRACE_H
@@ -0,0 +1,138 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#ifndef LIBCMAES_SKYLINE_H
+#define LIBCMAES_SKYLINE_H
+
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+using LengthUnit = unsigned long;
+using CounterPoint = std::pair<LengthUnit, LengthUnit>;
+
+// counter points of a palette stored contiguously as a staircase: x grows and y falls with the index.
+// Prefix sums over the points give the space wasted below an item in O(1), they are rebuilt after every placement.
+// All sums are unsigned, so their wrap-around cancels out and totals equal the point by point accumulation.
+class Skyline {
+public:
+    Skyline() : points{{0, 0}} {
+        updateSums();
+    }
+
+    long size() const {
+        return long(points.size());
+    }
+
+    bool empty() const {
+        return points.empty();
+    }
+
+    const CounterPoint &operator[](long index) const {
+        return points[index];
+    }
+
+    // first point left of index (inclusive) that an item with given top border covers
+    long findTopLeft(long index, LengthUnit topBorder) const {
+        return std::partition_point(points.begin(), points.begin() + index,
+                                    [topBorder](const CounterPoint &cp) { return cp.second > topBorder; }) -
+               points.begin();
+    }
+
+    // last point right of index (inclusive) that an item with given right border covers
+    long findBottomRight(long index, LengthUnit rightBorder) const {
+        return std::partition_point(points.begin() + index + 1, points.end(),
+                                    [rightBorder](const CounterPoint &cp) { return cp.first <= rightBorder; }) -
+               points.begin() - 1;
+    }
+
+    // wasted width, height and area between the item's top border and the steps in [topLeft, index)
+    void addLeftWaste(long topLeft, long index, LengthUnit topBorder,
+                      LengthUnit &wastedWidth, LengthUnit &wastedHeight, LengthUnit &wastedArea) const {
+        LengthUnit width = points[index].first - points[topLeft].first;
+        wastedWidth += width;
+        wastedHeight += LengthUnit(index - topLeft) * topBorder - (ySums[index] - ySums[topLeft]);
+        wastedArea += topBorder * width - (leftAreaSums[index] - leftAreaSums[topLeft]);
+    }
+
+    // wasted width, height and area between the item's right border and the steps in (index, bottomRight]
+    void addRightWaste(long index, long bottomRight, LengthUnit rightBorder,
+                       LengthUnit &wastedWidth, LengthUnit &wastedHeight, LengthUnit &wastedArea) const {
+        LengthUnit height = points[index].second - points[bottomRight].second;
+        wastedWidth += LengthUnit(bottomRight - index) * rightBorder - (xSums[bottomRight + 1] - xSums[index + 1]);
+        wastedHeight += height;
+        wastedArea += rightBorder * height - (rightAreaSums[bottomRight] - rightAreaSums[index]);
+    }
+
+    // area above the steps with at least minHeight free above them, the only place left for items whose sides are
+    // all at least minHeight: an item above a step lies between the step and the palette top
+    LengthUnit freeArea(LengthUnit paletteWidth, LengthUnit paletteHeight, LengthUnit minHeight) const {
+        LengthUnit result = 0;
+        auto pointsNumber = points.size();
+        for (size_t i = 0; i < pointsNumber; i++) {
+            LengthUnit headroom = paletteHeight - points[i].second;
+            LengthUnit nextX = i + 1 < pointsNumber ? points[i + 1].first : paletteWidth;
+            if (headroom >= minHeight)
+                result += (nextX - points[i].first) * headroom;
+        }
+        return result;
+    }
+
+    // replaces points [topLeft, bottomRight] covered by an item, paletteWidth and paletteHeight close the staircase
+    void place(long topLeft, long bottomRight, LengthUnit rightBorder, LengthUnit topBorder,
+               LengthUnit paletteWidth, LengthUnit paletteHeight) {
+        if (topLeft == bottomRight) {
+            if (topBorder != paletteHeight) {
+                points.emplace(points.begin() + bottomRight, points[topLeft].first, topBorder);
+                bottomRight++;
+            }
+        } else {
+            points.erase(points.begin() + topLeft + 1, points.begin() + bottomRight);
+            bottomRight = topLeft + 1;
+            if (topBorder == paletteHeight) {
+                points.erase(points.begin());
+                bottomRight--;
+            } else points[topLeft].second = topBorder;
+        }
+
+        //remove last cp if it's placed at right border
+        if (rightBorder == paletteWidth)
+            points.pop_back();
+        else points[bottomRight].first = rightBorder;
+
+        updateSums();
+    }
+
+private:
+    std::vector<CounterPoint> points;
+    std::vector<LengthUnit> xSums; //xSums[i] = sum of x over points [0, i)
+    std::vector<LengthUnit> ySums; //ySums[i] = sum of y over points [0, i)
+    std::vector<LengthUnit> leftAreaSums; //sum over steps [0, i) of step width times step y
+    std::vector<LengthUnit> rightAreaSums; //sum over steps [0, i) of next x times step height
+
+    void updateSums() {
+        auto pointsNumber = points.size();
+        xSums.resize(pointsNumber + 1);
+        ySums.resize(pointsNumber + 1);
+        leftAreaSums.resize(pointsNumber + 1);
+        rightAreaSums.resize(pointsNumber + 1);
+        xSums[0] = ySums[0] = leftAreaSums[0] = rightAreaSums[0] = 0;
+
+        for (size_t i = 0; i < pointsNumber; i++) {
+            xSums[i + 1] = xSums[i] + points[i].first;
+            ySums[i + 1] = ySums[i] + points[i].second;
+            if (i + 1 < pointsNumber) {
+                leftAreaSums[i + 1] = leftAreaSums[i] + (points[i + 1].first - points[i].first) * points[i].second;
+                rightAreaSums[i + 1] = rightAreaSums[i] + points[i + 1].first * (points[i].second - points[i + 1].second);
+            } else {
+                leftAreaSums[i + 1] = leftAreaSums[i];
+                rightAreaSums[i + 1] = rightAreaSums[i];
+            }
+        }
+    }
+};
+
+
+#endif //LIBCMAES_SKYLINE_H
@@ -0,0 +1,110 @@
+//
+// Created by deikare on 28.05.23.
+//
+
+#ifndef LIBCMAES_VALIDATION_H
+#define LIBCMAES_VALIDATION_H
+
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <future>
+#include <algorithm>
+#include "Palette.h"
+#include "InstanceCorpus.h"
+
+struct ValidationStats {
+    std::vector<double> results; //fill ratio per corpus instance
+    double mean = 0.0;
+    double median = 0.0;
+    double lowerDecile = 0.0;
+    double upperDecile = 0.0;
+    double worst = 0.0;
+    size_t worstInstance = 0;
+
+    // linear interpolation between the closest ranks, q in [0, 1]
+    double quantile(double q) const {
+        if (results.empty())
+            return 0.0;
+        std::vector<double> sorted(results);
+        std::sort(sorted.begin(), sorted.end());
+        double rank = q * double(sorted.size() - 1);
+        auto lower = size_t(rank);
+        auto upper = std::min(lower + 1, sorted.size() - 1);
+        return sorted[lower] + (rank - double(lower)) * (sorted[upper] - sorted[lower]);
+    }
+};
+
+// rates networks on every instance of a corpus, instances are spread over threads
+class Validator {
+public:
+    Validator(const InstanceCorpus &corpus, unsigned levelsNumber,
+              unsigned threadsNumber = std::max(1u, std::thread::hardware_concurrency())) : corpus(corpus),
+                                                                                            levelsNumber(levelsNumber),
+                                                                                            threadsNumber(
+                                                                                                    threadsNumber) {}
+
+    // traces of every instance are written to traceDirectory/instance<i>.trace when it is not empty
+    ValidationStats validate(const NeuralNetwork &network, const std::string &traceDirectory = "") const {
+        ValidationStats stats;
+        stats.results.resize(corpus.size());
+
+        std::atomic<size_t> nextInstance{0};
+        auto worker = [&]() {
+            for (size_t i = nextInstance++; i < corpus.size(); i = nextInstance++) {
+                InstanceView instance = corpus[i];
+                Palette palette(instance.getPaletteSize().first, instance.getPaletteSize().second,
+                                instance.getItems(), network, levelsNumber);
+                if (traceDirectory.empty())
+                    stats.results[i] = palette.performSimulation();
+                else
+                    stats.results[i] = palette.performSimulationWithSaveToFile(
+                            traceDirectory + "/instance" + std::to_string(i) + ".trace");
+            }
+        };
+
+        std::vector<std::thread> threads;
+        auto helpersNumber = std::min<size_t>(threadsNumber, corpus.size());
+        for (size_t t = 1; t < helpersNumber; t++)
+            threads.emplace_back(worker);
+        worker(); //the calling thread takes its share
+        for (auto &thread: threads)
+            thread.join();
+
+        summarize(stats);
+        return stats;
+    }
+
+    // validate() on its own thread, e.g. from a progress function every few generations so that the optimizer
+    // keeps running. network shares its parameters, so it has to own them, see NeuralNetwork(nodesInLayersCount, x)
+    std::future<ValidationStats> validateAsync(const NeuralNetwork &network) const {
+        return std::async(std::launch::async, [this, network]() { return validate(network); });
+    }
+
+private:
+    const InstanceCorpus &corpus;
+    const unsigned levelsNumber;
+    const unsigned threadsNumber;
+
+    static void summarize(ValidationStats &stats) {
+        if (stats.results.empty())
+            return;
+
+        for (double result: stats.results)
+            stats.mean += result;
+        stats.mean /= double(stats.results.size());
+
+        auto worst = std::min_element(stats.results.begin(), stats.results.end());
+        stats.worst = *worst;
+        stats.worstInstance = size_t(worst - stats.results.begin());
+
+        stats.median = stats.quantile(0.5);
+        stats.lowerDecile = stats.quantile(0.1);
+        stats.upperDecile = stats.quantile(0.9);
+    }
+};
+
+
+#endif //LIBCMAES_VALIDATION_H
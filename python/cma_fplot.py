@@ -0,0 +1,130 @@
+#!/usr/bin/env python
+"""Reader of the binary plot files (set_fplot_binary), and converter
+to the text format. In a OS shell::
+
+    python cma_fplot.py data_file_name.bin data_file_name.dat [--full]
+
+or in a python shell::
+
+    import cma_fplot
+    fplot = cma_fplot.read(data_file_name)
+    fplot.fields['xmean'] # iterations and values of the mean
+
+"""
+# CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+# Copyright (c) 2014 Inria
+# Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+#
+# This file is part of libcmaes.
+#
+# libcmaes is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# libcmaes is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+##
+
+import sys, struct, time
+
+magic = b'LCMAESFP'
+
+# fields in file order, see FPlotField in fplotwriter.h
+field_names = ['scalars','xbest','eigenvalues','stds','xmean','phases']
+
+# values of the scalars field
+scalar_names = ['fvalue','fevals','sigma','kappa','best_seen_fvalue','median_fvalue','worst_seen_fvalue','min_eigenv','max_eigenv','elapsed_last_iter']
+
+# values of the phases field, see Phase in phasetimers.h
+phase_names = ['ask','eigen','pheno','eval','tell','sort','cov_update','stop','uh','surr_train','surr_predict','uh_eval']
+
+class FPlot:
+    """content of a binary plot file: dim, seed, decimation per field name,
+    and per field name the pair (iterations, rows of values) of the
+    records holding the field."""
+    def __init__(self):
+        self.dim = 0
+        self.seed = 0
+        self.decimation = {}
+        self.fields = {}
+        self.niters = []
+
+def is_binary(filename):
+    with open(filename,'rb') as f:
+        return f.read(len(magic)) == magic
+
+def read(filename):
+    with open(filename,'rb') as f:
+        data = f.read()
+    if data[:len(magic)] != magic:
+        raise ValueError(filename + ' is not a binary plot file')
+    pos = len(magic)
+    version, dim, seed, nfields, _ = struct.unpack_from('=IIQII',data,pos)
+    pos += struct.calcsize('=IIQII')
+    if version != 1:
+        raise ValueError('unsupported binary plot file version ' + str(version))
+    fplot = FPlot()
+    fplot.dim = dim
+    fplot.seed = seed
+    widths = []
+    for f in range(nfields):
+        fid, width, every, _ = struct.unpack_from('=IIII',data,pos)
+        pos += 16
+        name = field_names[fid] if fid < len(field_names) else 'field' + str(fid)
+        widths.append((name,width))
+        fplot.decimation[name] = every
+        fplot.fields[name] = ([],[])
+    record = struct.calcsize('=qII')
+    while pos + record <= len(data):
+        niter, mask, _ = struct.unpack_from('=qII',data,pos)
+        pos += record
+        fplot.niters.append(niter)
+        for f, (name, width) in enumerate(widths):
+            if mask & (1 << f):
+                fplot.fields[name][0].append(niter)
+                fplot.fields[name][1].append(list(struct.unpack_from('=' + str(width) + 'd',data,pos)))
+                pos += 8 * width
+    return fplot
+
+def legacy_rows(fplot, full=False):
+    """rows of the text output, plain or full. Fields missing from a
+    record due to decimation repeat their last written values, zeros
+    before the first one."""
+    dim = fplot.dim
+    last = {}
+    for name, (niters, rows) in fplot.fields.items():
+        last[name] = [0.0] * (len(rows[0]) if rows else (10 if name == 'scalars' else dim))
+    nexts = dict((name,0) for name in fplot.fields)
+    out = []
+    for niter in fplot.niters:
+        for name, (niters, rows) in fplot.fields.items():
+            if nexts[name] < len(niters) and niters[nexts[name]] == niter:
+                last[name] = rows[nexts[name]]
+                nexts[name] += 1
+        s = last['scalars']
+        if full:
+            row = s[:9] + last['xbest'] + last['eigenvalues'] + last['stds'] + last['xmean'] + [s[9]]
+        else:
+            row = s[:4] + last['eigenvalues'] + last['stds'] + last['xmean'] + [s[9]]
+        out.append(row)
+    return out
+
+def convert(infile, outfile, full=False):
+    fplot = read(infile)
+    with open(outfile,'w') as f:
+        if full:
+            f.write(str(fplot.dim) + ' ' + str(fplot.seed) + ' / ' + time.ctime() + '\n\n')
+        for row in legacy_rows(fplot,full):
+            f.write(' '.join('%.15g' % v for v in row) + '\n')
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print('usage: python cma_fplot.py data_file_name.bin data_file_name.dat [--full]')
+        sys.exit(1)
+    convert(sys.argv[1],sys.argv[2],'--full' in sys.argv[3:])
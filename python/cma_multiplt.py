@@ -2,6 +2,8 @@
 """In a OS shell::
 
     python cma_multiplt.py data_file_name
+
+with data_file_name in text or binary format (see cma_fplot.py)
     
 or in a python shell::
 
@@ -31,6 +33,7 @@ or in a python shell::
 
 import sys, pylab, csv
 import numpy as np
+import cma_fplot
 from matplotlib.pylab import subplot, semilogy, grid, title
 # from matplotlib.pylab import figure, subplot, semilogy, hold, grid, axis, title, text, xlabel, isinteractive, draw, gcf
 # TODO: the above direct imports clutter the interface in a Python shell
@@ -40,7 +43,10 @@ single_values = 4
 
 def plot(filename):
     # read data into numpy array
-    dat = np.loadtxt(filename,dtype=float)
+    if cma_fplot.is_binary(filename):
+        dat = np.array(cma_fplot.legacy_rows(cma_fplot.read(filename)),dtype=float)
+    else:
+        dat = np.loadtxt(filename,dtype=float)
 
     dim = int(np.ceil(np.shape(dat)[1] - single_values) / 3) # we estimate the problem dimension from the data
     #print dim
@@ -89,6 +89,16 @@ boost::python::list get_solution_xmean(const CMASolutions &s)
   return xmean;
 }
 
+uint64_t eval_context_seed()
+{
+  return eval_context()._seed;
+}
+
+int eval_context_generation()
+{
+  return eval_context()._generation;
+}
+
 boost::python::list get_candidate_x(const Candidate &c)
 {
   boost::python::list x;
@@ -265,6 +275,13 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("set_fixed_p",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_fixed_p,"freeze a function parameter to a given value during optimization")
     .def("unset_fixed_p",&CMAParameters<GenoPheno<NoBoundStrategy>>::unset_fixed_p,"unfreeze a function parameter")
     .def("set_restarts",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_restarts,"set the maximum number of restarts (applies to IPOP and BIPOP)")
+    .def("set_islands",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_islands,"set the number of restarts run concurrently as islands (applies to IPOP and BIPOP)")
+    .def("get_islands",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_islands,"return the number of restarts run concurrently")
+    .def("set_islands_migration",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_islands_migration,"activate migration of the best solution found so far between islands")
+    .def("set_warm_restarts",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_warm_restarts,"activate restarts that inherit the shape of the previous covariance matrix")
+    .def("get_warm_restarts",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_warm_restarts,"whether warm restarts are activated")
+    .def("set_warm_restarts_cexp",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_warm_restarts_cexp,"set the exponent applied to the inherited eigenvalues on warm restarts, in [0,1]")
+    .def("set_warm_restarts_mix",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_warm_restarts_mix,"set the weight of the previous best point in the initial mean of warm restarts, in [0,1]")
     .def("set_max_iter",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_max_iter,"set the maximum number of iterations")
     .def("get_max_iter",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_max_iter,"return the maximum number of iterations")
     .def("set_max_fevals",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_max_fevals,"set the maximum number of function evaluation, i.e. budget")
@@ -281,16 +298,36 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("dim",&CMAParameters<GenoPheno<NoBoundStrategy>>::dim,"return the problem dimension")
     .def("set_quiet",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_quiet,"set the quiet mode (no output from the library)")
     .def("quiet",&CMAParameters<GenoPheno<NoBoundStrategy>>::quiet,"return the status of the quiet mode")
+    .def("set_log_every",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_log_every,"set the number of iterations between two progress lines")
+    .def("get_log_every",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_log_every,"return the number of iterations between two progress lines")
+    .def("set_log_kv",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_log_kv,"activate/deactivate progress lines as key=value pairs")
+    .def("get_log_kv",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_log_kv,"whether progress lines are key=value pairs")
     .def("set_str_algo",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_str_algo,"set the optimization algorithm, from cmaes,ipop,bipop,acmaes,aipop,abipop,sepcmaes,sepipop,sepbipop,sepacmaes,sepaipop,sepabipop,vdcma,vdipopcma,vdbipopcma")
     .def("get_algo",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_algo,"return the optimization algorithm code (0 to 14)")
     .def("set_fplot",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_fplot,"set the output filename (activate the output to file)")
     .def("get_fplot",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_fplot,"return the output filename")
     .def("set_full_fplot",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_full_fplot,"activates/deactivates the full output (for legacy plotting)")
+    .def("set_fplot_binary",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_fplot_binary,"activates/deactivates the binary output to file, written by a background thread, see cma_fplot.py")
+    .def("get_fplot_binary",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_fplot_binary,"whether the output to file is binary")
+    .def("set_fplot_decimation",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_fplot_decimation,"sets the number of iterations between two writes of a field of the binary output, 0 for never")
+    .def("get_fplot_decimation",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_fplot_decimation,"returns the number of iterations between two writes of a field of the binary output")
     .def("set_gradient",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_gradient,"activate the gradient injection scheme")
     .def("get_gradient",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_gradient,"return the status of the gradient injection scheme")
     .def("set_edm",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_edm,"activate the computation of expected distance to minimum after optimization has completed")
     .def("get_edm",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_edm,"get the status of the computation of expected distance to minimum")
     .def("set_mt_feval",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_mt_feval,"activate / deactivate the parallel evaluations of the objective function")
+    .def("set_deterministic",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_deterministic,"activate / deactivate the deterministic mode, in which results depend on the seed only")
+    .def("set_crn",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_crn,"activate / deactivate common random numbers, objective function calls of a generation share the seed returned by eval_context_seed()")
+    .def("set_eval_cache",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_eval_cache,"activate the cache of objective function values, with max size and quantization step (0 for exact matches)")
+    .def("set_phase_timing",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_phase_timing,"activate / deactivate the timing of the phases of every optimization step (on by default)")
+    .def("get_phase_timing",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_phase_timing,"return the status of the timing of phases")
+    .def("set_trace_file",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_trace_file,"activate the recording of a timeline of the optimization, written as Chrome trace JSON to the given file (empty to deactivate)")
+    .def("get_trace_file",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_trace_file,"return the timeline output file")
+    .def("set_checkpoint",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_checkpoint,"activate periodic checkpoints of the search state to the given file (empty to deactivate), every given number of iterations")
+    .def("get_checkpoint_file",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_checkpoint_file,"return the checkpoint file")
+    .def("get_checkpoint_every",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_checkpoint_every,"return the number of iterations between two checkpoints")
+    .def("set_resume",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_resume,"activate / deactivate resuming from the checkpoint file, when it exists")
+    .def("get_resume",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_resume,"return whether to resume from the checkpoint file")
     .def("get_mt_feval",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_mt_feval,"get the status of the parallel evaluations of the objective function")
     .def("set_uh",&CMAParameters<GenoPheno<NoBoundStrategy>>::set_uh,"activate the uncertainty handling scheme")
     .def("get_uh",&CMAParameters<GenoPheno<NoBoundStrategy>>::get_uh,"return the status of the uncertainty handling scheme")
@@ -306,6 +343,13 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("set_fixed_p",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_fixed_p,"freeze a function parameter to a given value during optimization")
     .def("unset_fixed_p",&CMAParameters<GenoPheno<pwqBoundStrategy>>::unset_fixed_p,"unfreeze a function parameter")
     .def("set_restarts",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_restarts,"set the maximum number of restarts (applies to IPOP and BIPOP)")
+    .def("set_islands",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_islands,"set the number of restarts run concurrently as islands (applies to IPOP and BIPOP)")
+    .def("get_islands",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_islands,"return the number of restarts run concurrently")
+    .def("set_islands_migration",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_islands_migration,"activate migration of the best solution found so far between islands")
+    .def("set_warm_restarts",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_warm_restarts,"activate restarts that inherit the shape of the previous covariance matrix")
+    .def("get_warm_restarts",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_warm_restarts,"whether warm restarts are activated")
+    .def("set_warm_restarts_cexp",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_warm_restarts_cexp,"set the exponent applied to the inherited eigenvalues on warm restarts, in [0,1]")
+    .def("set_warm_restarts_mix",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_warm_restarts_mix,"set the weight of the previous best point in the initial mean of warm restarts, in [0,1]")
     .def("set_max_iter",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_max_iter,"set the maximum number of iterations")
     .def("get_max_iter",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_max_iter,"return the maximum number of iterations")
     .def("set_max_fevals",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_max_fevals,"set the maximum number of function evaluation, i.e. budget")
@@ -322,16 +366,36 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("dim",&CMAParameters<GenoPheno<pwqBoundStrategy>>::dim,"return the problem dimension")
     .def("set_quiet",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_quiet,"set the quiet mode (no output from the library)")
     .def("quiet",&CMAParameters<GenoPheno<pwqBoundStrategy>>::quiet,"return the status of the quiet mode")
+    .def("set_log_every",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_log_every,"set the number of iterations between two progress lines")
+    .def("get_log_every",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_log_every,"return the number of iterations between two progress lines")
+    .def("set_log_kv",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_log_kv,"activate/deactivate progress lines as key=value pairs")
+    .def("get_log_kv",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_log_kv,"whether progress lines are key=value pairs")
     .def("set_str_algo",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_str_algo,"set the optimization algorithm, from cmaes,ipop,bipop,acmaes,aipop,abipop,sepcmaes,sepipop,sepbipop,sepacmaes,sepaipop,sepabipop,vdcma,vdipopcma,vdbipopcma")
     .def("get_algo",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_algo,"return the optimization algorithm code (0 to 14)")
     .def("set_fplot",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_fplot,"set the output filename (activate the output to file)")
     .def("get_fplot",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_fplot,"return the output filename")
     .def("set_full_fplot",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_full_fplot,"activates/deactivates the full output (for legacy plotting)")
+    .def("set_fplot_binary",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_fplot_binary,"activates/deactivates the binary output to file, written by a background thread, see cma_fplot.py")
+    .def("get_fplot_binary",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_fplot_binary,"whether the output to file is binary")
+    .def("set_fplot_decimation",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_fplot_decimation,"sets the number of iterations between two writes of a field of the binary output, 0 for never")
+    .def("get_fplot_decimation",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_fplot_decimation,"returns the number of iterations between two writes of a field of the binary output")
     .def("set_gradient",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_gradient,"activate the gradient injection scheme")
     .def("get_gradient",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_gradient,"return the status of the gradient injection scheme")
     .def("set_edm",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_edm,"activate the computation of expected distance to minimum after optimization has completed")
     .def("get_edm",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_edm,"get the status of the computation of expected distance to minimum")
     .def("set_mt_feval",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_mt_feval,"activate / deactivate the parallel evaluations of the objective function")
+    .def("set_deterministic",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_deterministic,"activate / deactivate the deterministic mode, in which results depend on the seed only")
+    .def("set_crn",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_crn,"activate / deactivate common random numbers, objective function calls of a generation share the seed returned by eval_context_seed()")
+    .def("set_eval_cache",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_eval_cache,"activate the cache of objective function values, with max size and quantization step (0 for exact matches)")
+    .def("set_phase_timing",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_phase_timing,"activate / deactivate the timing of the phases of every optimization step (on by default)")
+    .def("get_phase_timing",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_phase_timing,"return the status of the timing of phases")
+    .def("set_trace_file",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_trace_file,"activate the recording of a timeline of the optimization, written as Chrome trace JSON to the given file (empty to deactivate)")
+    .def("get_trace_file",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_trace_file,"return the timeline output file")
+    .def("set_checkpoint",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_checkpoint,"activate periodic checkpoints of the search state to the given file (empty to deactivate), every given number of iterations")
+    .def("get_checkpoint_file",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_checkpoint_file,"return the checkpoint file")
+    .def("get_checkpoint_every",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_checkpoint_every,"return the number of iterations between two checkpoints")
+    .def("set_resume",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_resume,"activate / deactivate resuming from the checkpoint file, when it exists")
+    .def("get_resume",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_resume,"return whether to resume from the checkpoint file")
     .def("get_mt_feval",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_mt_feval,"get the status of the parallel evaluations of the objective function")
     .def("set_uh",&CMAParameters<GenoPheno<pwqBoundStrategy>>::set_uh,"activate the uncertainty handling scheme")
     .def("get_uh",&CMAParameters<GenoPheno<pwqBoundStrategy>>::get_uh,"return the status of the uncertainty handling scheme")
@@ -346,6 +410,13 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("set_fixed_p",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_fixed_p,"freeze a function parameter to a given value during optimization")
     .def("unset_fixed_p",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::unset_fixed_p,"unfreeze a function parameter")
     .def("set_restarts",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_restarts,"set the maximum number of restarts (applies to IPOP and BIPOP)")
+    .def("set_islands",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_islands,"set the number of restarts run concurrently as islands (applies to IPOP and BIPOP)")
+    .def("get_islands",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_islands,"return the number of restarts run concurrently")
+    .def("set_islands_migration",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_islands_migration,"activate migration of the best solution found so far between islands")
+    .def("set_warm_restarts",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_warm_restarts,"activate restarts that inherit the shape of the previous covariance matrix")
+    .def("get_warm_restarts",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_warm_restarts,"whether warm restarts are activated")
+    .def("set_warm_restarts_cexp",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_warm_restarts_cexp,"set the exponent applied to the inherited eigenvalues on warm restarts, in [0,1]")
+    .def("set_warm_restarts_mix",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_warm_restarts_mix,"set the weight of the previous best point in the initial mean of warm restarts, in [0,1]")
     .def("set_max_iter",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_max_iter,"set the maximum number of iterations")
     .def("get_max_iter",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_max_iter,"return the maximum number of iterations")
     .def("set_max_fevals",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_max_fevals,"set the maximum number of function evaluation, i.e. budget")
@@ -362,16 +433,36 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("dim",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::dim,"return the problem dimension")
     .def("set_quiet",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_quiet,"set the quiet mode (no output from the library)")
     .def("quiet",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::quiet,"return the status of the quiet mode")
+    .def("set_log_every",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_log_every,"set the number of iterations between two progress lines")
+    .def("get_log_every",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_log_every,"return the number of iterations between two progress lines")
+    .def("set_log_kv",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_log_kv,"activate/deactivate progress lines as key=value pairs")
+    .def("get_log_kv",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_log_kv,"whether progress lines are key=value pairs")
     .def("set_str_algo",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_str_algo,"set the optimization algorithm, from cmaes,ipop,bipop,acmaes,aipop,abipop,sepcmaes,sepipop,sepbipop,sepacmaes,sepaipop,sepabipop,vdcma,vdipopcma,vdbipopcma")
     .def("get_algo",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_algo,"return the optimization algorithm code (0 to 14)")
     .def("set_fplot",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_fplot,"set the output filename (activate the output to file)")
     .def("get_fplot",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_fplot,"return the output filename")
     .def("set_full_fplot",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_full_fplot,"activates/deactivates the full output (for legacy plotting)")
+    .def("set_fplot_binary",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_fplot_binary,"activates/deactivates the binary output to file, written by a background thread, see cma_fplot.py")
+    .def("get_fplot_binary",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_fplot_binary,"whether the output to file is binary")
+    .def("set_fplot_decimation",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_fplot_decimation,"sets the number of iterations between two writes of a field of the binary output, 0 for never")
+    .def("get_fplot_decimation",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_fplot_decimation,"returns the number of iterations between two writes of a field of the binary output")
     .def("set_gradient",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_gradient,"activate the gradient injection scheme")
     .def("get_gradient",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_gradient,"return the status of the gradient injection scheme")
     .def("set_edm",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_edm,"activate the computation of expected distance to minimum after optimization has completed")
     .def("get_edm",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_edm,"get the status of the computation of expected distance to minimum")
     .def("set_mt_feval",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_mt_feval,"activate / deactivate the parallel evaluations of the objective function")
+    .def("set_deterministic",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_deterministic,"activate / deactivate the deterministic mode, in which results depend on the seed only")
+    .def("set_crn",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_crn,"activate / deactivate common random numbers, objective function calls of a generation share the seed returned by eval_context_seed()")
+    .def("set_eval_cache",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_eval_cache,"activate the cache of objective function values, with max size and quantization step (0 for exact matches)")
+    .def("set_phase_timing",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_phase_timing,"activate / deactivate the timing of the phases of every optimization step (on by default)")
+    .def("get_phase_timing",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_phase_timing,"return the status of the timing of phases")
+    .def("set_trace_file",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_trace_file,"activate the recording of a timeline of the optimization, written as Chrome trace JSON to the given file (empty to deactivate)")
+    .def("get_trace_file",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_trace_file,"return the timeline output file")
+    .def("set_checkpoint",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_checkpoint,"activate periodic checkpoints of the search state to the given file (empty to deactivate), every given number of iterations")
+    .def("get_checkpoint_file",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_checkpoint_file,"return the checkpoint file")
+    .def("get_checkpoint_every",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_checkpoint_every,"return the number of iterations between two checkpoints")
+    .def("set_resume",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_resume,"activate / deactivate resuming from the checkpoint file, when it exists")
+    .def("get_resume",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_resume,"return whether to resume from the checkpoint file")
     .def("get_mt_feval",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_mt_feval,"get the status of the parallel evaluations of the objective function")
     .def("set_uh",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::set_uh,"activate the uncertainty handling scheme")
     .def("get_uh",&CMAParameters<GenoPheno<NoBoundStrategy,linScalingStrategy>>::get_uh,"return the status of the uncertainty handling scheme")
@@ -386,6 +477,13 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("set_fixed_p",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_fixed_p,"freeze a function parameter to a given value during optimization")
     .def("unset_fixed_p",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::unset_fixed_p,"unfreeze a function parameter")
     .def("set_restarts",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_restarts,"set the maximum number of restarts (applies to IPOP and BIPOP)")
+    .def("set_islands",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_islands,"set the number of restarts run concurrently as islands (applies to IPOP and BIPOP)")
+    .def("get_islands",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_islands,"return the number of restarts run concurrently")
+    .def("set_islands_migration",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_islands_migration,"activate migration of the best solution found so far between islands")
+    .def("set_warm_restarts",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_warm_restarts,"activate restarts that inherit the shape of the previous covariance matrix")
+    .def("get_warm_restarts",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_warm_restarts,"whether warm restarts are activated")
+    .def("set_warm_restarts_cexp",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_warm_restarts_cexp,"set the exponent applied to the inherited eigenvalues on warm restarts, in [0,1]")
+    .def("set_warm_restarts_mix",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_warm_restarts_mix,"set the weight of the previous best point in the initial mean of warm restarts, in [0,1]")
     .def("set_max_iter",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_max_iter,"set the maximum number of iterations")
     .def("get_max_iter",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_max_iter,"return the maximum number of iterations")
     .def("set_max_fevals",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_max_fevals,"set the maximum number of function evaluation, i.e. budget")
@@ -402,16 +500,36 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("dim",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::dim,"return the problem dimension")
     .def("set_quiet",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_quiet,"set the quiet mode (no output from the library)")
     .def("quiet",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::quiet,"return the status of the quiet mode")
+    .def("set_log_every",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_log_every,"set the number of iterations between two progress lines")
+    .def("get_log_every",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_log_every,"return the number of iterations between two progress lines")
+    .def("set_log_kv",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_log_kv,"activate/deactivate progress lines as key=value pairs")
+    .def("get_log_kv",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_log_kv,"whether progress lines are key=value pairs")
     .def("set_str_algo",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_str_algo,"set the optimization algorithm, from cmaes,ipop,bipop,acmaes,aipop,abipop,sepcmaes,sepipop,sepbipop,sepacmaes,sepaipop,sepabipop,vdcma,vdipopcma,vdbipopcma")
     .def("get_algo",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_algo,"return the optimization algorithm code (0 to 14)")
     .def("set_fplot",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_fplot,"set the output filename (activate the output to file)")
     .def("get_fplot",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_fplot,"return the output filename")
     .def("set_full_fplot",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_full_fplot,"activates/deactivates the full output (for legacy plotting)")
+    .def("set_fplot_binary",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_fplot_binary,"activates/deactivates the binary output to file, written by a background thread, see cma_fplot.py")
+    .def("get_fplot_binary",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_fplot_binary,"whether the output to file is binary")
+    .def("set_fplot_decimation",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_fplot_decimation,"sets the number of iterations between two writes of a field of the binary output, 0 for never")
+    .def("get_fplot_decimation",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_fplot_decimation,"returns the number of iterations between two writes of a field of the binary output")
     .def("set_gradient",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_gradient,"activate the gradient injection scheme")
     .def("get_gradient",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_gradient,"return the status of the gradient injection scheme")
     .def("set_edm",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_edm,"activate the computation of expected distance to minimum after optimization has completed")
     .def("get_edm",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_edm,"get the status of the computation of expected distance to minimum")
     .def("set_mt_feval",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_mt_feval,"activate / deactivate the parallel evaluations of the objective function")
+    .def("set_deterministic",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_deterministic,"activate / deactivate the deterministic mode, in which results depend on the seed only")
+    .def("set_crn",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_crn,"activate / deactivate common random numbers, objective function calls of a generation share the seed returned by eval_context_seed()")
+    .def("set_eval_cache",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_eval_cache,"activate the cache of objective function values, with max size and quantization step (0 for exact matches)")
+    .def("set_phase_timing",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_phase_timing,"activate / deactivate the timing of the phases of every optimization step (on by default)")
+    .def("get_phase_timing",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_phase_timing,"return the status of the timing of phases")
+    .def("set_trace_file",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_trace_file,"activate the recording of a timeline of the optimization, written as Chrome trace JSON to the given file (empty to deactivate)")
+    .def("get_trace_file",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_trace_file,"return the timeline output file")
+    .def("set_checkpoint",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_checkpoint,"activate periodic checkpoints of the search state to the given file (empty to deactivate), every given number of iterations")
+    .def("get_checkpoint_file",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_checkpoint_file,"return the checkpoint file")
+    .def("get_checkpoint_every",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_checkpoint_every,"return the number of iterations between two checkpoints")
+    .def("set_resume",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_resume,"activate / deactivate resuming from the checkpoint file, when it exists")
+    .def("get_resume",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_resume,"return whether to resume from the checkpoint file")
     .def("get_mt_feval",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_mt_feval,"get the status of the parallel evaluations of the objective function")
     .def("set_uh",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::set_uh,"activate the uncertainty handling scheme")
     .def("get_uh",&CMAParameters<GenoPheno<pwqBoundStrategy,linScalingStrategy>>::get_uh,"return the status of the uncertainty handling scheme")
@@ -434,6 +552,8 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("edm",&CMASolutions::edm,"returns the expected distance to minimum, if computed (see set_edm() in CMAParameters)")
     .def("sigma",&CMASolutions::sigma,"returns current value of step-size sigma")
     .def("fevals",&CMASolutions::fevals,"returns current number of objective function evaluations")
+    .def("cache_hits",&CMASolutions::cache_hits,"returns the number of objective function values found in cache")
+    .def("cache_misses",&CMASolutions::cache_misses,"returns the number of objective function values not found in cache")
     .def("eigenvalues",&CMASolutions::eigenvalues,"returns a vector of last computed eigenvalues")
     .def("min_eigenv",&CMASolutions::min_eigenv,"returns current min eigen value")
     .def("max_eigenv",&CMASolutions::max_eigenv,"returns current max eigen value")
@@ -441,12 +561,52 @@ BOOST_PYTHON_MODULE(lcmaes)
     .def("run_status_msg",&CMASolutions::status_msg,"returns current optimization status message")
     .def("elapsed_time",&CMASolutions::elapsed_time,"returns current elapsed time spent on optimization")
     .def("elapsed_last_iter",&CMASolutions::elapsed_last_iter,"returns time taken by last iteration")
+    .def("phase_stats",&CMASolutions::phase_stats,return_value_policy<copy_const_reference>(),"returns the timing statistics of a phase (see Phase), in nanoseconds")
+    .def("phase_timing",&CMASolutions::phase_timing,"returns whether phases are being timed")
+    .def("set_phase_timing",&CMASolutions::set_phase_timing,"turns the timing of phases on or off during the run")
     .def("niter",&CMASolutions::niter,"returns current number of iterations")
     ;
   def("get_solution_xmean",get_solution_xmean,args("sol"),"returns current mean vector of objective function parameters");
   def("get_solution_cov",get_solution_cov,args("sol"),"returns current covariance matrix");
   def("get_solution_sepcov",get_solution_sepcov,args("sol"),"returns current diagonal covariance matrix, only for sep-* and vd-* algorithms");
 
+  /*- binary plot file -*/
+  enum_<FPlotField>("FPlotField")
+    .value("scalars",FPLOT_SCALARS)
+    .value("xbest",FPLOT_XBEST)
+    .value("eigenvalues",FPLOT_EIGENVALUES)
+    .value("stds",FPLOT_STDS)
+    .value("xmean",FPLOT_XMEAN)
+    .value("phases",FPLOT_PHASES)
+    ;
+
+  /*- phase timing -*/
+  enum_<Phase>("Phase")
+    .value("ask",PHASE_ASK)
+    .value("eigen",PHASE_EIGEN)
+    .value("pheno",PHASE_PHENO)
+    .value("eval",PHASE_EVAL)
+    .value("tell",PHASE_TELL)
+    .value("sort",PHASE_SORT)
+    .value("cov_update",PHASE_COV_UPDATE)
+    .value("stop",PHASE_STOP)
+    .value("uh",PHASE_UH)
+    .value("surr_train",PHASE_SURR_TRAIN)
+    .value("surr_predict",PHASE_SURR_PREDICT)
+    .value("uh_eval",PHASE_UH_EVAL)
+    ;
+  class_<PhaseStats>("PhaseStats","timing statistics of a phase, in nanoseconds, with a histogram of power of two buckets")
+    .def("count",&PhaseStats::count,"returns the number of timed calls")
+    .def("total",&PhaseStats::total,"returns the cumulative time of the phase")
+    .def("last",&PhaseStats::last,"returns the latency of the last timed call")
+    .def("min",&PhaseStats::min,"returns the smallest latency")
+    .def("max",&PhaseStats::max,"returns the largest latency")
+    .def("mean",&PhaseStats::mean,"returns the mean latency")
+    .def("bucket",&PhaseStats::bucket,"returns the number of latencies in [2^(b-1),2^b[")
+    .def("quantile",&PhaseStats::quantile,"returns an upper bound of the q-quantile of latencies")
+    ;
+  def("phase_name",&PhaseTimers::name,args("phase"),"returns the name of a phase");
+
   /*- solution candidate object -*/
   class_<Candidate>("Candidate","candidate solution point in objective function parameter space")
     .def("get_fvalue",&Candidate::get_fvalue,"returns candidate's objective function value")
@@ -454,6 +614,8 @@ BOOST_PYTHON_MODULE(lcmaes)
     ;
   def("get_candidate_x",get_candidate_x,args("cand"),"returns candidate's parameter vector");
   def("get_best_candidate_pheno",get_best_candidate_pheno,args("cmasol","gp"),"returns candidate's parameter vector in phenotype space");
+  def("eval_context_seed",eval_context_seed,"returns the seed of the current generation's evaluation context, from within the objective function");
+  def("eval_context_generation",eval_context_generation,"returns the generation of the current evaluation context, from within the objective function");
 
   /*- genopheno object -*/
   class_<GenoPheno<NoBoundStrategy>>("GenoPhenoNB","genotype/phenotype transformation object for problem with unbounded parameters")
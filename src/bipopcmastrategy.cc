@@ -25,6 +25,8 @@
 #include <libcmaes/llogging.h>
 #include <ctime>
 #include <array>
+#include <algorithm>
+#include <sstream>
 
 namespace libcmaes
 {
@@ -35,13 +37,15 @@ namespace libcmaes
   {
     std::random_device rd;
     _gen = std::mt19937(rd());
-    _gen.seed(static_cast<uint64_t>(time(nullptr)));
+    _gen.seed(parameters._deterministic ? parameters.stream_seed(STREAM_BIPOP) : static_cast<uint64_t>(time(nullptr)));
     _unif = std::uniform_real_distribution<>(0,1);
     CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda = _lambda_def;
     CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._mu = floor(_lambda_def / 2.0);
     CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions = CMASolutions(CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters);
     _sigma_init = parameters._sigma_init;
     _max_fevals = parameters._max_fevals;
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_put_restarts = std::bind(&BIPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::put_restarts,this,std::placeholders::_1);
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_get_restarts = std::bind(&BIPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::get_restarts,this,std::placeholders::_1);
   }
 
   template <class TCovarianceUpdate, class TGenoPheno>
@@ -52,11 +56,13 @@ namespace libcmaes
   {
     std::random_device rd;
     _gen = std::mt19937(rd());
-    _gen.seed(static_cast<uint64_t>(time(nullptr)));
+    _gen.seed(parameters._deterministic ? parameters.stream_seed(STREAM_BIPOP) : static_cast<uint64_t>(time(nullptr)));
     _unif = std::uniform_real_distribution<>(0,1);
     CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda = _lambda_def;
     CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._mu = floor(_lambda_def / 2.0);
     //CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions = CMASolutions(CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters);
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_put_restarts = std::bind(&BIPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::put_restarts,this,std::placeholders::_1);
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_get_restarts = std::bind(&BIPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::get_restarts,this,std::placeholders::_1);
   }
 
   template <class TCovarianceUpdate, class TGenoPheno>
@@ -75,30 +81,122 @@ namespace libcmaes
 							       const AskFunc &askf,
 							       const TellFunc &tellf)
   {
-    std::array<int,2> budgets = {{0,0}}; // 0: r1, 1: r2
-    CMASolutions best_run;
-    for (int r=0;r<CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._nrestarts;r++)
+    typedef IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno> ipop;
+    bool resumed = CMAStrategy<TCovarianceUpdate,TGenoPheno>::_resumed; // continues the checkpointed run of the checkpointed regime.
+    if (!resumed)
       {
-	while(budgets[0]>budgets[1])
+	_budgets = {{0,0}};
+	_regime = 0;
+	ipop::_restart = 0;
+	ipop::_best_run = CMASolutions();
+      }
+    if (CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._nislands > 1)
+      {
+	// small population restarts run alongside the large population one as long as
+	// their budget, including the one reserved by running islands, stays below r1's.
+	// The running large population restart counts for its evaluations so far, or for
+	// twice the previous one's since its lambda doubled, whichever is larger, so that
+	// small islands start right away. The small budget left is split evenly among the
+	// free islands so that none idles while it lasts.
+	static const int small_iters = 10; // fewest iterations of a small population restart.
+	int reserved = 0, nsmall = 0;
+	bool large_running = false;
+	int large_evals = 0, large_expected = 0;
+	int r = 0, nruns = 0;
+	return ipop::optimize_islands([&](CMAParameters<TGenoPheno> &p, int &regime) -> int
+				      {
+					int large = large_running ? std::max(large_evals,large_expected) : 0;
+					int available = _budgets[0] + large - _budgets[1] - reserved;
+					int nsplit = std::min(p._nislands - nsmall - (large_running ? 1 : 0),
+							      static_cast<int>(available / (small_iters * _lambda_def))); // free islands.
+					int small_budget = nsplit > 0 ? available / nsplit : 0;
+					if (!large_running && r < p._nrestarts)
+					  {
+					    if (r > 0) // use lambda_def on first call.
+					      r1();
+					    p._lambda = _lambda_l;
+					    p._sigma_init = _sigma_init;
+					    p.initialize_parameters();
+					    p.set_max_fevals(_max_fevals);
+					    large_running = true;
+					    large_evals = 0;
+					    ++r;
+					    regime = 0;
+					  }
+					else if (small_budget > 0)
+					  {
+					    double u = _unif(_gen);
+					    double us = _unif(_gen);
+					    double nsigma = 2.0*pow(10,-2.0*us);
+					    double nlambda = ceil(_lambda_def * pow(0.5*(_lambda_l/_lambda_def),u));
+					    LOG_IF(INFO,!p._quiet) << "Island => lambda_s=" << nlambda << " / lambda_l=" << _lambda_l << " / lambda_def=" << _lambda_def << " / nsigma=" << nsigma << " / budget=" << small_budget << std::endl;
+					    p._lambda = nlambda;
+					    p._sigma_init = nsigma;
+					    p.initialize_parameters();
+					    p.set_max_fevals(small_budget);
+					    reserved += small_budget;
+					    ++nsmall;
+					    regime = 1;
+					  }
+					else if (large_running || nsmall > 0)
+					  return ipop::ISLAND_WAIT;
+					else return ipop::ISLAND_DONE;
+					p._seed += nruns++;
+					return ipop::ISLAND_RUN;
+				      },
+				      [&](const CMAParameters<TGenoPheno> &p, const int &regime, const CMASolutions &sols)
+				      {
+					_budgets[regime] += sols._niter * p._lambda;
+					if (regime == 0)
+					  {
+					    large_running = false;
+					    large_expected = 2 * sols._niter * p._lambda;
+					  }
+					else
+					  {
+					    reserved -= p._max_fevals;
+					    --nsmall;
+					  }
+				      },
+				      [&](const CMAParameters<TGenoPheno> &p, const int &regime, const CMASolutions &sols)
+				      {
+					if (regime == 0)
+					  large_evals = sols._niter * p._lambda;
+				      });
+      }
+    
+    for (;ipop::_restart<CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._nrestarts;ipop::_restart++)
+      {
+	while(_budgets[0]>_budgets[1] || (resumed && _regime == 1))
 	  {
-	    r2();
-	    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters.set_max_fevals(0.5*budgets[0]);
-	    IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::reset_search_state();
+	    if (!resumed)
+	      {
+		r2();
+		CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters.set_max_fevals(0.5*_budgets[0]);
+		IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::reset_search_state();
+	      }
+	    resumed = false;
+	    _regime = 1;
 	    CMAStrategy<TCovarianceUpdate,TGenoPheno>::optimize(evalf,askf,tellf);
-	    budgets[1] += CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions._niter * CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda;
-	    IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::capture_best_solution(best_run);
+	    _budgets[1] += CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions._niter * CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda;
+	    IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::capture_best_solution(ipop::_best_run);
 	  }
-	if (r > 0) // use lambda_def on first call.
+	if (!resumed)
 	  {
-	    r1();
-	    IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::reset_search_state();
+	    if (ipop::_restart > 0) // use lambda_def on first call.
+	      {
+		r1();
+		IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::reset_search_state();
+	      }
+	    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters.set_max_fevals(_max_fevals); // resets the budget
 	  }
-	CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters.set_max_fevals(_max_fevals); // resets the budget
+	resumed = false;
+	_regime = 0;
 	CMAStrategy<TCovarianceUpdate,TGenoPheno>::optimize(evalf,askf,tellf);
-	budgets[0] += CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions._niter * CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda;
-	IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::capture_best_solution(best_run);
+	_budgets[0] += CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions._niter * CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda;
+	IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::capture_best_solution(ipop::_best_run);
       }
-    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions = best_run;
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions = ipop::_best_run;
     if (CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions._run_status >= 0)
       return OPTI_SUCCESS;
     else return OPTI_ERR_TERMINATION; // exact termination code is in CMAStrategy<TCovarianceUpdate>::_solutions._run_status.
@@ -127,6 +225,49 @@ namespace libcmaes
     CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters.initialize_parameters();
   }
 
+  template <class TCovarianceUpdate, class TGenoPheno>
+  void BIPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::put_restarts(CheckpointOut &out) const
+  {
+    IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::put_restarts(out);
+    out.put(_budgets[0]);
+    out.put(_budgets[1]);
+    out.put(_regime);
+    out.put(_lambda_l);
+    std::ostringstream gen;
+    gen << _gen << ' ' << _unif;
+    out.put(gen.str());
+  }
+
+  template <class TCovarianceUpdate, class TGenoPheno>
+  std::function<void()> BIPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::get_restarts(CheckpointIn &in)
+  {
+    std::function<void()> set_ipop = IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::get_restarts(in);
+    std::array<int,2> budgets = {{0,0}};
+    int regime = 0;
+    double lambda_l = 0.0;
+    std::string gen;
+    in.get(budgets[0]);
+    in.get(budgets[1]);
+    in.get(regime);
+    in.get(lambda_l);
+    in.get(gen);
+    std::mt19937 rgen;
+    std::uniform_real_distribution<> unif;
+    std::istringstream genin(gen);
+    genin >> rgen >> unif;
+    if (!set_ipop || !in.good() || genin.fail())
+      return nullptr;
+    return [=]()
+      {
+	set_ipop();
+	_budgets = budgets;
+	_regime = regime;
+	_lambda_l = lambda_l;
+	_gen = rgen;
+	_unif = unif;
+      };
+  }
+
   template class CMAES_EXPORT BIPOPCMAStrategy<CovarianceUpdate,GenoPheno<NoBoundStrategy> >;
   template class CMAES_EXPORT BIPOPCMAStrategy<ACovarianceUpdate,GenoPheno<NoBoundStrategy> >;
   template class CMAES_EXPORT BIPOPCMAStrategy<VDCMAUpdate,GenoPheno<NoBoundStrategy> >;
@@ -0,0 +1,156 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libcmaes/checkpoint.h>
+#include <libcmaes/cmasolutions.h>
+#include <iterator>
+
+namespace libcmaes
+{
+  static const char checkpoint_magic[8] = {'L','C','M','A','E','S','C','K'};
+
+  void Checkpoint::put_header(CheckpointOut &out, const int &dim, const uint64_t &seed)
+  {
+    uint32_t version = _version;
+    out.raw(checkpoint_magic,sizeof(checkpoint_magic));
+    out.put(version);
+    out.put(dim);
+    out.put(seed);
+  }
+
+  bool Checkpoint::get_header(CheckpointIn &in, const int &dim, uint64_t &seed)
+  {
+    char magic[sizeof(checkpoint_magic)] = {0};
+    uint32_t version = 0;
+    int cdim = 0;
+    in.raw(magic,sizeof(magic));
+    in.get(version);
+    in.get(cdim);
+    in.get(seed);
+    return in.good() && std::memcmp(magic,checkpoint_magic,sizeof(magic)) == 0
+      && version == _version && cdim == dim;
+  }
+
+  void Checkpoint::put(CheckpointOut &out, const CMASolutions &sols)
+  {
+    out.put(sols._cov);
+    out.put(sols._csqinv);
+    out.put(sols._sepcov);
+    out.put(sols._sepcsqinv);
+    out.put(sols._xmean);
+    out.put(sols._psigma);
+    out.put(sols._pc);
+    out.put(sols._hsig);
+    out.put(sols._sigma);
+    out.put(sols._candidates);
+    out.put(sols._best_candidates_hist);
+    out.put(sols._max_hist);
+    out.put(sols._max_eigenv);
+    out.put(sols._min_eigenv);
+    out.put(sols._leigenvalues);
+    out.put(sols._leigenvectors);
+    out.put(sols._niter);
+    out.put(sols._nevals);
+    out.put(sols._cache_hits);
+    out.put(sols._cache_misses);
+    out.put(sols._kcand);
+    out.put(sols._k_best_candidates_hist);
+    out.put(sols._bfvalues);
+    out.put(sols._median_fvalues);
+    out.put(sols._eigeniter);
+    out.put(sols._updated_eigen);
+    out.put(sols._run_status);
+    out.put(sols._elapsed_time);
+    out.put(sols._elapsed_last_iter);
+    out.put(sols._best_seen_candidate);
+    out.put(sols._best_seen_iter);
+    out.put(sols._worst_seen_candidate);
+    out.put(sols._initial_candidate);
+    out.put(sols._v);
+    out.put(sols._lambda_reev);
+    out.put(sols._suh);
+    out.put(sols._tpa_s);
+    out.put(sols._tpa_p1);
+    out.put(sols._tpa_p2);
+    out.put(sols._tpa_x1);
+    out.put(sols._tpa_x2);
+    out.put(sols._xmean_prev);
+  }
+
+  void Checkpoint::get(CheckpointIn &in, CMASolutions &sols)
+  {
+    in.get(sols._cov);
+    in.get(sols._csqinv);
+    in.get(sols._sepcov);
+    in.get(sols._sepcsqinv);
+    in.get(sols._xmean);
+    in.get(sols._psigma);
+    in.get(sols._pc);
+    in.get(sols._hsig);
+    in.get(sols._sigma);
+    in.get(sols._candidates);
+    in.get(sols._best_candidates_hist);
+    in.get(sols._max_hist);
+    in.get(sols._max_eigenv);
+    in.get(sols._min_eigenv);
+    in.get(sols._leigenvalues);
+    in.get(sols._leigenvectors);
+    in.get(sols._niter);
+    in.get(sols._nevals);
+    in.get(sols._cache_hits);
+    in.get(sols._cache_misses);
+    in.get(sols._kcand);
+    in.get(sols._k_best_candidates_hist);
+    in.get(sols._bfvalues);
+    in.get(sols._median_fvalues);
+    in.get(sols._eigeniter);
+    in.get(sols._updated_eigen);
+    in.get(sols._run_status);
+    in.get(sols._elapsed_time);
+    in.get(sols._elapsed_last_iter);
+    in.get(sols._best_seen_candidate);
+    in.get(sols._best_seen_iter);
+    in.get(sols._worst_seen_candidate);
+    in.get(sols._initial_candidate);
+    in.get(sols._v);
+    in.get(sols._lambda_reev);
+    in.get(sols._suh);
+    in.get(sols._tpa_s);
+    in.get(sols._tpa_p1);
+    in.get(sols._tpa_p2);
+    in.get(sols._tpa_x1);
+    in.get(sols._tpa_x2);
+    in.get(sols._xmean_prev);
+    sols._candidates_uh.clear();
+    sols._pls.clear();
+    sols._edm = 0.0;
+    sols._timers.reset();
+  }
+
+  bool Checkpoint::read_file(const std::string &filename, std::vector<char> &buf)
+  {
+    std::ifstream in(filename,std::ios::binary);
+    if (!in)
+      return false;
+    buf.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+    return !in.bad();
+  }
+}
@@ -23,6 +23,7 @@
 #include <libcmaes/opti_err.h>
 #include <libcmaes/eigenmvn.h>
 #include <limits>
+#include <random>
 #include <iostream>
 
 namespace libcmaes
@@ -31,6 +32,7 @@ namespace libcmaes
   CMASolutions::CMASolutions(Parameters<TGenoPheno> &p)
     :_hsig(1),_max_eigenv(0.0),_min_eigenv(0.0),_niter(0),_nevals(0),_kcand(1),_eigeniter(0),_updated_eigen(true),_run_status(0),_elapsed_time(0)
   {
+    _timers.set_enabled(p._phase_timing);
     try
       {
 	if (!static_cast<CMAParameters<TGenoPheno>&>(p)._sep && !static_cast<CMAParameters<TGenoPheno>&>(p)._vd)
@@ -42,15 +44,25 @@ namespace libcmaes
 	_run_status = OPTI_ERR_OUTOFMEMORY;
 	return;
       }
+    dVec urand; // uniform in [-1,1].
+    if (p._deterministic)
+      {
+	std::mt19937 gen(p.stream_seed(STREAM_MEAN,p._mean_draws++)); // a new point on every restart.
+	std::uniform_real_distribution<> unif(-1.0,1.0);
+	urand = dVec(p._dim);
+	for (int i=0;i<p._dim;i++)
+	  urand(i) = unif(gen);
+      }
+    else urand = dVec::Random(p._dim);
     if (p._x0min == p._x0max)
       {
 	if (p._x0min == dVec::Constant(p._dim,-std::numeric_limits<double>::max()))
-	  _xmean = dVec::Random(p._dim) * 4.0; // initial mean randomly sampled from -4,4 in all dimensions.
+	  _xmean = urand * 4.0; // initial mean randomly sampled from -4,4 in all dimensions.
 	else _xmean = p._x0min;
       }
     else
       {
-	_xmean = 0.5*(dVec::Random(p._dim) + dVec::Constant(p._dim,1.0)); // scale to [0,1].
+	_xmean = 0.5*(urand + dVec::Constant(p._dim,1.0)); // scale to [0,1].
 	_xmean = _xmean.cwiseProduct(p._x0max - p._x0min) + p._x0min; // scale to bounds.
       }
     if (!p._fixed_p.empty())
@@ -78,6 +90,8 @@ namespace libcmaes
     if (static_cast<CMAParameters<TGenoPheno>&>(p)._vd)
       {
 	Eigen::EigenMultivariateNormal<double> esolver(false,static_cast<uint64_t>(p._seed));
+	if (p._deterministic)
+	  esolver.set_stream(p.stream_seed(STREAM_VD));
 	esolver.set_covar(_sepcov);
 	_v = esolver.samples_ind(1) / std::sqrt(p._dim);
       }
@@ -221,9 +235,7 @@ namespace libcmaes
     _median_fvalues.clear();
     _run_status = 0;
     _elapsed_time = _elapsed_last_iter = 0;
-#ifdef HAVE_DEBUG
-    _elapsed_eval = _elapsed_ask = _elapsed_tell = _elapsed_stop = 0;
-#endif
+    _timers.reset();
   }
   
   void CMASolutions::reset_as_fixed(const int &k)
@@ -248,9 +260,7 @@ namespace libcmaes
     _median_fvalues.clear();
     _run_status = 0;
     _elapsed_time = _elapsed_last_iter = 0;
-#ifdef HAVE_DEBUG
-    _elapsed_eval = _elapsed_ask = _elapsed_tell = _elapsed_stop = 0;
-#endif
+    _timers.reset();
   }
   
   template <class TGenoPheno>
@@ -28,10 +28,6 @@
 #include <limits>
 #include <iostream>
 
-#ifdef HAVE_DEBUG
-#include <chrono>
-#endif
-
 namespace libcmaes
 {
 
@@ -258,9 +254,6 @@ namespace libcmaes
   template <class TGenoPheno>
   int CMAStopCriteria<TGenoPheno>::stop(const CMAParameters<TGenoPheno> &cmap, const CMASolutions &cmas) const
   {
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstart = std::chrono::system_clock::now();
-#endif
     if (!_active)
       return 0;
     int r = 0;
@@ -271,10 +264,6 @@ namespace libcmaes
 	    return r;
 	  }
       }
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstop = std::chrono::system_clock::now();
-    const_cast<CMASolutions&>(cmas)._elapsed_stop = std::chrono::duration_cast<std::chrono::milliseconds>(tstop-tstart).count();
-#endif
     return CONT;
   }
 
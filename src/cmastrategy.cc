@@ -37,7 +37,9 @@ namespace libcmaes
   template <class TCovarianceUpdate, class TGenoPheno>
   int pfuncdef_impl(const CMAParameters<TGenoPheno> &cmaparams, const CMASolutions &cmasols)
   {
-    LOG_IF(INFO,!cmaparams.quiet()) << std::setprecision(std::numeric_limits<double>::digits10) << "iter=" << cmasols.niter() << " / evals=" << cmasols.fevals() << " / f-value=" << cmasols.best_candidate().get_fvalue() <<  " / sigma=" << cmasols.sigma() << " / last_iter=" << cmasols.elapsed_last_iter() << std::endl;
+    if (cmaparams.get_log_kv())
+      LOG_IF(INFO,cmaparams.log_due(cmasols.niter())) << std::setprecision(std::numeric_limits<double>::digits10) << "iter=" << cmasols.niter() << " evals=" << cmasols.fevals() << " fvalue=" << cmasols.best_candidate().get_fvalue() << " sigma=" << cmasols.sigma() << " last_iter=" << cmasols.elapsed_last_iter() << std::endl;
+    else LOG_IF(INFO,cmaparams.log_due(cmasols.niter())) << std::setprecision(std::numeric_limits<double>::digits10) << "iter=" << cmasols.niter() << " / evals=" << cmasols.fevals() << " / f-value=" << cmasols.best_candidate().get_fvalue() <<  " / sigma=" << cmasols.sigma() << " / last_iter=" << cmasols.elapsed_last_iter() << std::endl;
     return 0;
   }
   template <class TCovarianceUpdate, class TGenoPheno>
@@ -65,11 +67,65 @@ namespace libcmaes
     fplotstream << cmaparams.get_gp().pheno(cmasols.xmean()).transpose();
     fplotstream << sep << cmasols.elapsed_last_iter();
 #ifdef HAVE_DEBUG
-    fplotstream << sep << cmasols._elapsed_eval << sep << cmasols._elapsed_ask << sep << cmasols._elapsed_tell << sep << cmasols._elapsed_stop;
+    fplotstream << sep << cmasols.phase_stats(PHASE_EVAL).last() / 1e6 << sep << cmasols.phase_stats(PHASE_ASK).last() / 1e6 << sep << cmasols.phase_stats(PHASE_TELL).last() / 1e6 << sep << cmasols.phase_stats(PHASE_STOP).last() / 1e6; // ms
 #endif
     fplotstream << std::endl;
     return 0;
     }
+  template<class TCovarianceUpdate, class TGenoPheno>
+  FPlotWriter* fplotwriter_open(const CMAParameters<TGenoPheno> &cmaparams)
+  {
+    std::vector<int> widths = {10,cmaparams.dim(),cmaparams.dim(),cmaparams.dim(),cmaparams.dim(),PHASE_COUNT};
+    std::vector<int> decimation;
+    for (int f=0;f<FPLOT_NFIELDS;f++)
+      decimation.push_back(cmaparams.get_fplot_decimation(f));
+    FPlotWriter *fplotwriter = new FPlotWriter(cmaparams.get_fplot(),cmaparams.dim(),cmaparams.get_seed(),widths,decimation);
+    if (!fplotwriter->good())
+      LOG(ERROR) << "cannot open binary plot file " << cmaparams.get_fplot() << std::endl;
+    return fplotwriter;
+  }
+
+  template<class TCovarianceUpdate, class TGenoPheno>
+  void fpbinary_impl(const CMAParameters<TGenoPheno> &cmaparams, const CMASolutions &cmasols, FPlotWriter &fplotwriter)
+  {
+    fplotwriter.begin(cmasols.niter());
+    if (fplotwriter.due(FPLOT_SCALARS))
+      {
+	double scalars[10] = {fabs(cmasols.best_candidate().get_fvalue()),static_cast<double>(cmasols.fevals()),cmasols.sigma(),(cmasols.min_eigenv() == 0 ? 1.0 : sqrt(cmasols.max_eigenv()/cmasols.min_eigenv())),
+			      cmasols.get_best_seen_candidate().get_fvalue(),cmasols.get_candidate(cmasols.size() / 2).get_fvalue(),cmasols.get_worst_seen_candidate().get_fvalue(),
+			      cmasols.min_eigenv(),cmasols.max_eigenv(),static_cast<double>(cmasols.elapsed_last_iter())}; // same order as the full text output.
+	fplotwriter.put(FPLOT_SCALARS,scalars,10);
+      }
+    if (fplotwriter.due(FPLOT_XBEST))
+      {
+	dVec xbest = cmasols.get_best_seen_candidate().get_x_size() ? cmasols.get_best_seen_candidate().get_x_dvec() : dVec::Zero(cmaparams.dim());
+	fplotwriter.put(FPLOT_XBEST,xbest.data(),cmaparams.dim());
+      }
+    if (fplotwriter.due(FPLOT_EIGENVALUES))
+      {
+	dVec eigenvalues = cmasols.eigenvalues().size() ? cmasols.eigenvalues() : dVec::Zero(cmaparams.dim());
+	fplotwriter.put(FPLOT_EIGENVALUES,eigenvalues.data(),cmaparams.dim());
+      }
+    if (fplotwriter.due(FPLOT_STDS))
+      {
+	dVec stds = cmasols.stds(cmaparams);
+	fplotwriter.put(FPLOT_STDS,stds.data(),cmaparams.dim());
+      }
+    if (fplotwriter.due(FPLOT_XMEAN))
+      {
+	dVec xmean = cmaparams.get_gp().pheno(cmasols.xmean());
+	fplotwriter.put(FPLOT_XMEAN,xmean.data(),cmaparams.dim());
+      }
+    if (fplotwriter.due(FPLOT_PHASES))
+      {
+	double phases[PHASE_COUNT];
+	for (int p=0;p<PHASE_COUNT;p++)
+	  phases[p] = cmasols.phase_stats(p).last() / 1e6; // ms
+	fplotwriter.put(FPLOT_PHASES,phases,PHASE_COUNT);
+      }
+    fplotwriter.end();
+  }
+
   template<class TCovarianceUpdate, class TGenoPheno>
   int fpfuncdef_impl(const CMAParameters<TGenoPheno> &cmaparams, const CMASolutions &cmasols, std::ofstream &fplotstream)
   {
@@ -82,7 +138,7 @@ namespace libcmaes
     fplotstream << cmaparams.get_gp().pheno(cmasols.xmean()).transpose();
     fplotstream << sep << cmasols.elapsed_last_iter();
 #ifdef HAVE_DEBUG
-    fplotstream << sep << cmasols._elapsed_eval << sep << cmasols._elapsed_ask << sep << cmasols._elapsed_tell << sep << cmasols._elapsed_stop;
+    fplotstream << sep << cmasols.phase_stats(PHASE_EVAL).last() / 1e6 << sep << cmasols.phase_stats(PHASE_ASK).last() / 1e6 << sep << cmasols.phase_stats(PHASE_TELL).last() / 1e6 << sep << cmasols.phase_stats(PHASE_STOP).last() / 1e6; // ms
 #endif
     fplotstream << std::endl;
     return 0;
@@ -109,9 +165,16 @@ namespace libcmaes
     LOG_IF(INFO,!eostrat<TGenoPheno>::_parameters._quiet) << "CMA-ES / dim=" << eostrat<TGenoPheno>::_parameters._dim << " / lambda=" << eostrat<TGenoPheno>::_parameters._lambda << " / sigma0=" << eostrat<TGenoPheno>::_solutions._sigma << " / mu=" << eostrat<TGenoPheno>::_parameters._mu << " / mueff=" << eostrat<TGenoPheno>::_parameters._muw << " / c1=" << eostrat<TGenoPheno>::_parameters._c1 << " / cmu=" << eostrat<TGenoPheno>::_parameters._cmu << " / tpa=" << (eostrat<TGenoPheno>::_parameters._tpa==2) << " / threads=" << Eigen::nbThreads() << std::endl;
     if (!eostrat<TGenoPheno>::_parameters._fplot.empty())
       {
-	_fplotstream = new std::ofstream(eostrat<TGenoPheno>::_parameters._fplot);
-	_fplotstream->precision(std::numeric_limits<double>::digits10);
+	if (eostrat<TGenoPheno>::_parameters._fplot_binary)
+	  _fplotwriter = fplotwriter_open<TCovarianceUpdate,TGenoPheno>(eostrat<TGenoPheno>::_parameters);
+	else
+	  {
+	    _fplotstream = new std::ofstream(eostrat<TGenoPheno>::_parameters._fplot);
+	    _fplotstream->precision(std::numeric_limits<double>::digits10);
+	  }
       }
+    if (!eostrat<TGenoPheno>::_parameters._checkpoint_file.empty())
+      _checkpointwriter = new CheckpointWriter(eostrat<TGenoPheno>::_parameters._checkpoint_file);
     auto mit=eostrat<TGenoPheno>::_parameters._stoppingcrit.begin();
     while(mit!=eostrat<TGenoPheno>::_parameters._stoppingcrit.end())
       {
@@ -133,22 +196,30 @@ namespace libcmaes
     _esolver = Eigen::EigenMultivariateNormal<double>(false,eostrat<TGenoPheno>::_parameters._seed); // seeding the multivariate normal generator.
     LOG_IF(INFO,!eostrat<TGenoPheno>::_parameters._quiet) << "CMA-ES / dim=" << eostrat<TGenoPheno>::_parameters._dim << " / lambda=" << eostrat<TGenoPheno>::_parameters._lambda << " / sigma0=" << eostrat<TGenoPheno>::_solutions._sigma << " / mu=" << eostrat<TGenoPheno>::_parameters._mu << " / mueff=" << eostrat<TGenoPheno>::_parameters._muw << " / c1=" << eostrat<TGenoPheno>::_parameters._c1 << " / cmu=" << eostrat<TGenoPheno>::_parameters._cmu << " / lazy_update=" << eostrat<TGenoPheno>::_parameters._lazy_update << std::endl;
     if (!eostrat<TGenoPheno>::_parameters._fplot.empty())
-      _fplotstream = new std::ofstream(eostrat<TGenoPheno>::_parameters._fplot);
+      {
+	if (eostrat<TGenoPheno>::_parameters._fplot_binary)
+	  _fplotwriter = fplotwriter_open<TCovarianceUpdate,TGenoPheno>(eostrat<TGenoPheno>::_parameters);
+	else _fplotstream = new std::ofstream(eostrat<TGenoPheno>::_parameters._fplot);
+      }
+    if (!eostrat<TGenoPheno>::_parameters._checkpoint_file.empty())
+      _checkpointwriter = new CheckpointWriter(eostrat<TGenoPheno>::_parameters._checkpoint_file);
   }
 
   template <class TCovarianceUpdate, class TGenoPheno>
   CMAStrategy<TCovarianceUpdate,TGenoPheno>::~CMAStrategy()
   {
-    if (!eostrat<TGenoPheno>::_parameters._fplot.empty())
-      delete _fplotstream;
+    delete _fplotstream;
+    delete _fplotwriter; // writes out the remaining records.
+    delete _checkpointwriter; // writes out the last checkpoint.
   }
   
   template <class TCovarianceUpdate, class TGenoPheno>
   dMat CMAStrategy<TCovarianceUpdate,TGenoPheno>::ask()
   {
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstart = std::chrono::system_clock::now();
-#endif
+    PhaseTimer ptimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_ASK,eostrat<TGenoPheno>::_tracer.get());
+    
+    // a new generation starts, candidates and their re-evaluations share its context.
+    this->next_eval_context();
     
     // compute eigenvalues and eigenvectors.
     if (!eostrat<TGenoPheno>::_parameters._sep && !eostrat<TGenoPheno>::_parameters._vd)
@@ -159,6 +230,7 @@ namespace libcmaes
 	  {
 	    eostrat<TGenoPheno>::_solutions._eigeniter = eostrat<TGenoPheno>::_niter;
 	    _esolver.setMean(eostrat<TGenoPheno>::_solutions._xmean);
+	    PhaseTimer etimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_EIGEN,eostrat<TGenoPheno>::_tracer.get());
 	    _esolver.setCovar(eostrat<TGenoPheno>::_solutions._cov);
 	    eostrat<TGenoPheno>::_solutions._updated_eigen = true;
 	  }
@@ -261,11 +333,6 @@ namespace libcmaes
       std::cerr << pop << std::endl;*/
     //debug
 
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstop = std::chrono::system_clock::now();
-    eostrat<TGenoPheno>::_solutions._elapsed_ask = std::chrono::duration_cast<std::chrono::milliseconds>(tstop-tstart).count();
-#endif
-    
     return pop;
   }
   
@@ -276,14 +343,19 @@ namespace libcmaes
     //DLOG(INFO) << "tell()\n";
     //debug
 
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstart = std::chrono::system_clock::now();
-#endif
+    PhaseTimer ptimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_TELL,eostrat<TGenoPheno>::_tracer.get());
     
     // sort candidates.
     if (!eostrat<TGenoPheno>::_parameters._uh)
-      eostrat<TGenoPheno>::_solutions.sort_candidates();
-    else eostrat<TGenoPheno>::uncertainty_handling();
+      {
+	PhaseTimer stimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_SORT,eostrat<TGenoPheno>::_tracer.get());
+	eostrat<TGenoPheno>::_solutions.sort_candidates();
+      }
+    else
+      {
+	PhaseTimer utimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_UH,eostrat<TGenoPheno>::_tracer.get());
+	eostrat<TGenoPheno>::uncertainty_handling();
+      }
     
     // call on tpa computation of s(t)
     if (eostrat<TGenoPheno>::_parameters._tpa == 2 && eostrat<TGenoPheno>::_niter > 0)
@@ -293,7 +365,10 @@ namespace libcmaes
     eostrat<TGenoPheno>::_solutions.update_best_candidates();
     
     // CMA-ES update, depends on the selected 'flavor'.
-    TCovarianceUpdate::update(eostrat<TGenoPheno>::_parameters,_esolver,eostrat<TGenoPheno>::_solutions);
+    {
+      PhaseTimer ctimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_COV_UPDATE,eostrat<TGenoPheno>::_tracer.get());
+      TCovarianceUpdate::update(eostrat<TGenoPheno>::_parameters,_esolver,eostrat<TGenoPheno>::_solutions);
+    }
     
     if (eostrat<TGenoPheno>::_parameters._uh)
       if (eostrat<TGenoPheno>::_solutions._suh > 0.0)
@@ -305,10 +380,6 @@ namespace libcmaes
 						    _esolver._eigenSolver.eigenvectors());
     else eostrat<TGenoPheno>::_solutions.update_eigenv(eostrat<TGenoPheno>::_solutions._sepcov,
 						       dMat::Constant(eostrat<TGenoPheno>::_parameters._dim,1,1.0));
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstop = std::chrono::system_clock::now();
-    eostrat<TGenoPheno>::_solutions._elapsed_tell = std::chrono::duration_cast<std::chrono::milliseconds>(tstop-tstart).count();
-#endif
   }
 
   template <class TCovarianceUpdate, class TGenoPheno>
@@ -326,6 +397,7 @@ namespace libcmaes
     if (eostrat<TGenoPheno>::_niter == 0)
       return false;
 
+    PhaseTimer ptimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_STOP,eostrat<TGenoPheno>::_tracer.get());
     if ((eostrat<TGenoPheno>::_solutions._run_status = _stopcriteria.stop(eostrat<TGenoPheno>::_parameters,eostrat<TGenoPheno>::_solutions)) != CONT)
       return true;
     else return false;
@@ -338,30 +410,53 @@ namespace libcmaes
     //DLOG(INFO) << "optimize()\n";
     //debug
 
-    if (eostrat<TGenoPheno>::_initial_elitist 
-	|| eostrat<TGenoPheno>::_parameters._initial_elitist
-	|| eostrat<TGenoPheno>::_parameters._elitist
-	|| eostrat<TGenoPheno>::_parameters._initial_fvalue)
+    // a resumed run has already evaluated its initial point, if any.
+    bool resumed = _resumed;
+    _resumed = false;
+    if (!resumed
+	&& (eostrat<TGenoPheno>::_initial_elitist 
+	    || eostrat<TGenoPheno>::_parameters._initial_elitist
+	    || eostrat<TGenoPheno>::_parameters._elitist
+	    || eostrat<TGenoPheno>::_parameters._initial_fvalue))
       {
-	eostrat<TGenoPheno>::_solutions._initial_candidate = Candidate(eostrat<TGenoPheno>::_func(eostrat<TGenoPheno>::_parameters._gp.pheno(eostrat<TGenoPheno>::_solutions._xmean).data(),eostrat<TGenoPheno>::_parameters._dim),
+	bool hit = false;
+	eostrat<TGenoPheno>::_solutions._initial_candidate = Candidate(this->fcall(eostrat<TGenoPheno>::_parameters._gp.pheno(eostrat<TGenoPheno>::_solutions._xmean).data(),eostrat<TGenoPheno>::_parameters._dim,hit),
 								       eostrat<TGenoPheno>::_solutions._xmean);
 	eostrat<TGenoPheno>::_solutions._best_seen_candidate = eostrat<TGenoPheno>::_solutions._initial_candidate;
-	this->update_fevals(1);
+	this->update_fevals_cached(hit);
       }
     
+    // fixed order of reductions in linear algebra, Eigen's parallel products depend on the number of threads.
+    int nthreads = Eigen::nbThreads();
+    if (eostrat<TGenoPheno>::_parameters._deterministic)
+      Eigen::setNbThreads(1);
+    
     std::chrono::time_point<std::chrono::system_clock> tstart = std::chrono::system_clock::now();
     while(!stop())
       {
+	Tracer::clock::time_point tgen;
+	if (eostrat<TGenoPheno>::_tracer)
+	  tgen = Tracer::clock::now();
 	dMat candidates = askf();
-	evalf(candidates,eostrat<TGenoPheno>::_parameters._gp.pheno(candidates));
+	dMat phenocandidates;
+	{
+	  PhaseTimer ptimer(eostrat<TGenoPheno>::_solutions._timers,PHASE_PHENO,eostrat<TGenoPheno>::_tracer.get());
+	  phenocandidates = eostrat<TGenoPheno>::_parameters._gp.pheno(candidates);
+	}
+	evalf(candidates,phenocandidates);
 	tellf();
+	if (eostrat<TGenoPheno>::_tracer)
+	  eostrat<TGenoPheno>::_tracer->span("generation",tgen,eostrat<TGenoPheno>::_niter,eostrat<TGenoPheno>::_solutions.best_candidate().get_fvalue());
 	eostrat<TGenoPheno>::inc_iter();
 	std::chrono::time_point<std::chrono::system_clock> tstop = std::chrono::system_clock::now();
 	eostrat<TGenoPheno>::_solutions._elapsed_last_iter = std::chrono::duration_cast<std::chrono::milliseconds>(tstop-tstart).count();
 	tstart = std::chrono::system_clock::now();
+	if (_checkpointwriter && eostrat<TGenoPheno>::_niter % eostrat<TGenoPheno>::_parameters._checkpoint_every == 0)
+	  checkpoint();
       }
     if (eostrat<TGenoPheno>::_parameters._with_edm)
       eostrat<TGenoPheno>::edm();
+    Eigen::setNbThreads(nthreads);
 
     // test on final value wrt. to best candidate value and number of iterations in between.
     if (eostrat<TGenoPheno>::_parameters._initial_elitist_on_restart)
@@ -391,7 +486,119 @@ namespace libcmaes
   template <class TCovarianceUpdate, class TGenoPheno>
   void CMAStrategy<TCovarianceUpdate,TGenoPheno>::plot()
   {
-    eostrat<TGenoPheno>::_pffunc(eostrat<TGenoPheno>::_parameters,eostrat<TGenoPheno>::_solutions,*_fplotstream);
+    if (_fplotwriter)
+      fpbinary_impl<TCovarianceUpdate,TGenoPheno>(eostrat<TGenoPheno>::_parameters,eostrat<TGenoPheno>::_solutions,*_fplotwriter);
+    else eostrat<TGenoPheno>::_pffunc(eostrat<TGenoPheno>::_parameters,eostrat<TGenoPheno>::_solutions,*_fplotstream);
+  }
+  
+  template <class TCovarianceUpdate, class TGenoPheno>
+  void CMAStrategy<TCovarianceUpdate,TGenoPheno>::checkpoint()
+  {
+    if (!_checkpointwriter)
+      return;
+    const CMAParameters<TGenoPheno> &parameters = eostrat<TGenoPheno>::_parameters;
+    CheckpointOut out;
+    Checkpoint::put_header(out,parameters._dim,parameters._seed);
+
+    // parameters changed by restarts.
+    out.put(parameters._lambda);
+    out.put(parameters._sigma_init);
+    out.put(parameters._max_fevals);
+    out.put(parameters._mean_draws);
+    out.put(parameters._x0min);
+    out.put(parameters._x0max);
+
+    // strategy, sampler and solutions.
+    this->put_state(out);
+    out.put(_esolver.rng_state());
+    out.put(_esolver.mean());
+    out.put(_esolver.covar()); // with lazy updates, the sampler's covariance lags behind the solutions'.
+    Checkpoint::put(out,eostrat<TGenoPheno>::_solutions);
+    out.put(static_cast<bool>(_put_restarts));
+    if (_put_restarts)
+      _put_restarts(out);
+    _checkpointwriter->submit(out._buf);
+  }
+
+  template <class TCovarianceUpdate, class TGenoPheno>
+  int CMAStrategy<TCovarianceUpdate,TGenoPheno>::resume(const std::string &filename)
+  {
+    CMAParameters<TGenoPheno> &parameters = eostrat<TGenoPheno>::_parameters;
+    std::vector<char> buf;
+    if (!Checkpoint::read_file(filename,buf))
+      {
+	LOG(ERROR) << "cannot read checkpoint file " << filename << std::endl;
+	return OPTI_ERR_CHECKPOINT;
+      }
+    CheckpointIn in(buf);
+    uint64_t seed = 0, mean_draws = 0;
+    int lambda = 0, max_fevals = 0;
+    double sigma_init = 0.0;
+    dVec x0min, x0max, mean;
+    dMat covar;
+    std::string rng;
+    bool restarts = false;
+    if (!Checkpoint::get_header(in,parameters._dim,seed))
+      {
+	LOG(ERROR) << "checkpoint file " << filename << " is not a checkpoint of version " << Checkpoint::_version << " and dimension " << parameters._dim << std::endl;
+	return OPTI_ERR_CHECKPOINT;
+      }
+    in.get(lambda);
+    in.get(sigma_init);
+    in.get(max_fevals);
+    in.get(mean_draws);
+    in.get(x0min);
+    in.get(x0max);
+    // everything is read into temporaries first, so that a bad checkpoint leaves the strategy as it was.
+    bool ok = in.good() && lambda > 0 && x0min.size() == parameters._dim && x0max.size() == parameters._dim;
+    std::function<void()> set_state = ok ? this->get_state(in) : nullptr;
+    std::function<void()> set_restarts;
+    CMASolutions solutions = eostrat<TGenoPheno>::_solutions;
+    in.get(rng);
+    in.get(mean);
+    in.get(covar);
+    Checkpoint::get(in,solutions);
+    in.get(restarts);
+    if (set_state && in.good() && restarts == static_cast<bool>(_get_restarts))
+      {
+	if (_get_restarts)
+	  set_restarts = _get_restarts(in);
+	ok = in.good() && (set_restarts || !_get_restarts)
+	  && solutions._xmean.size() == parameters._dim
+	  && (parameters._sep || parameters._vd || covar.size() == 0 || (mean.size() == parameters._dim && covar.rows() == parameters._dim && covar.cols() == parameters._dim))
+	  && Eigen::EigenMultivariateNormal<double>().set_rng_state(rng);
+      }
+    else ok = false;
+    if (!ok)
+      {
+	LOG(ERROR) << "checkpoint file " << filename << " is corrupted or comes from another strategy" << std::endl;
+	return OPTI_ERR_CHECKPOINT;
+      }
+
+    set_state();
+    eostrat<TGenoPheno>::_solutions = solutions;
+    if (set_restarts)
+      set_restarts();
+    _esolver.set_rng_state(rng);
+    parameters._seed = seed;
+    parameters._sigma_init = sigma_init;
+    if (lambda != parameters._lambda)
+      {
+	parameters._lambda = lambda;
+	parameters.initialize_parameters();
+      }
+    parameters._max_fevals = max_fevals;
+    parameters._mean_draws = mean_draws;
+    parameters._x0min = x0min;
+    parameters._x0max = x0max;
+    if (!parameters._sep && !parameters._vd && covar.size())
+      {
+	_esolver.setMean(mean);
+	_esolver.setCovar(covar); // same decomposition as the run that wrote the checkpoint.
+      }
+    _resumed = true;
+    LOG_IF(INFO,!parameters._quiet) << "resuming from checkpoint " << filename << " / iter=" << eostrat<TGenoPheno>::_niter << " / evals=" << eostrat<TGenoPheno>::_nevals << std::endl;
+    return OPTI_SUCCESS;
   }
   
   template class CMAStrategy<CovarianceUpdate,GenoPheno<NoBoundStrategy>>;
@@ -47,9 +47,17 @@ namespace libcmaes
     //debug
 
     pli le(k,samplesize,parameters._dim,parameters._gp.pheno(x),minfvalue,fup,delta);
+
+    // linesearches and inner optimizations revisit points, cache their values.
+    EvalCache cache(parameters.get_eval_cache_size(),parameters.get_eval_cache_quantum());
+    FitFunc cfunc = func;
+    if (cache.active())
+      cfunc = [&cache,&func](const double *x, const int &N) { bool hit; return cache.eval(func,x,N,hit); };
     
-    errstats<TGenoPheno>::profile_likelihood_search(func,parameters,le,cmasol,k,false,samplesize,fup,delta,maxiters,curve); // positive direction
-    errstats<TGenoPheno>::profile_likelihood_search(func,parameters,le,cmasol,k,true,samplesize,fup,delta,maxiters,curve);  // negative direction
+    errstats<TGenoPheno>::profile_likelihood_search(cfunc,parameters,le,cmasol,k,false,samplesize,fup,delta,maxiters,curve); // positive direction
+    errstats<TGenoPheno>::profile_likelihood_search(cfunc,parameters,le,cmasol,k,true,samplesize,fup,delta,maxiters,curve);  // negative direction
+    cmasol._cache_hits += cache.hits();
+    cmasol._cache_misses += cache.misses();
     
     le.setErrMinMax();
     cmasol._pls.insert(std::pair<int,pli>(k,le));
@@ -350,24 +358,30 @@ namespace libcmaes
 	cmasol.get_pli(py,ply); // in phenotype
       }
 
+    // inner optimizations and crossing searches revisit points, cache their values.
+    EvalCache cache(parameters.get_eval_cache_size(),parameters.get_eval_cache_quantum());
+    FitFunc cfunc = func;
+    if (cache.active())
+      cfunc = [&cache,&func](const double *x, const int &N) { bool hit; return cache.eval(func,x,N,hit); };
+
     dVec phenox = cmasol.best_candidate().get_x_pheno_dvec(parameters); // in phenotype
     double valx = phenox(px);
     double valy = phenox(py);
     
     // find upper y value for x parameter.
-    CMASolutions exy_up = errstats<TGenoPheno>::optimize_pk(func,parameters,cmasol,px,valx+plx._errmax,parameters.get_x0min());
+    CMASolutions exy_up = errstats<TGenoPheno>::optimize_pk(cfunc,parameters,cmasol,px,valx+plx._errmax,parameters.get_x0min());
     //std::cout << "exy_up=" << exy_up.best_candidate().get_x_dvec().transpose() << std::endl;
     
     // find lower y value for x parameter.
-    CMASolutions exy_lo = errstats<TGenoPheno>::optimize_pk(func,parameters,cmasol,px,valx+plx._errmin,parameters.get_x0min());
+    CMASolutions exy_lo = errstats<TGenoPheno>::optimize_pk(cfunc,parameters,cmasol,px,valx+plx._errmin,parameters.get_x0min());
     //std::cout << "exy_lo=" << exy_lo.best_candidate().get_x_dvec().transpose() << std::endl;
     
     // find upper x value for y parameter.
-    CMASolutions eyx_up = errstats<TGenoPheno>::optimize_pk(func,parameters,cmasol,py,valy+ply._errmax,parameters.get_x0min());
+    CMASolutions eyx_up = errstats<TGenoPheno>::optimize_pk(cfunc,parameters,cmasol,py,valy+ply._errmax,parameters.get_x0min());
     //std::cout << "eyx_up=" << eyx_up.best_candidate().get_x_dvec().transpose() << std::endl;
     
     // find lower x value for y parameter.
-    CMASolutions eyx_lo = errstats<TGenoPheno>::optimize_pk(func,parameters,cmasol,py,valy+ply._errmin,parameters.get_x0min());
+    CMASolutions eyx_lo = errstats<TGenoPheno>::optimize_pk(cfunc,parameters,cmasol,py,valy+ply._errmin,parameters.get_x0min());
     //std::cout << "eyx_lo=" << eyx_lo.best_candidate().get_x_dvec().transpose() << std::endl;
     
     // early contour in phenotype
@@ -435,7 +449,7 @@ namespace libcmaes
 	//debug
 	
 	// find crossing point from x with direction dir where function is equal to min + fup.
-	fcross fc = errstats<TGenoPheno>::cross(func,parameters,cmasol,fup,par,pmid,pdir,parameters._ftolerance);
+	fcross fc = errstats<TGenoPheno>::cross(cfunc,parameters,cmasol,fup,par,pmid,pdir,parameters._ftolerance);
 	if (fc._nevals == 0.0) // dummy
 	  continue;
 	
@@ -456,6 +470,9 @@ namespace libcmaes
     //debug
     //std::cout << "number of contour points=" << c._points.size() << std::endl;
     //debug
+
+    cmasol._cache_hits += cache.hits();
+    cmasol._cache_misses += cache.misses();
     
     return c;
   }
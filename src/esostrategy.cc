@@ -26,18 +26,27 @@
 #include <libcmaes/cmastopcriteria.h>
 #include <iostream>
 #include <numeric>
+#include <sstream>
 #include <libcmaes/llogging.h>
 
-#ifdef HAVE_DEBUG
-#include <chrono>
-#endif
-
 namespace libcmaes
 {
   template <typename T> int sgn(T val) {
     return (T(0) < val) - (val < T(0));
   }
 
+  static thread_local EvalContext tl_eval_context; // set before every objective function call.
+
+  const EvalContext& eval_context()
+  {
+    return tl_eval_context;
+  }
+
+  void set_eval_context(const EvalContext &context)
+  {
+    tl_eval_context = context;
+  }
+
   template<class TParameters,class TSolutions,class TStopCriteria>
   ESOStrategy<TParameters,TSolutions,TStopCriteria>::ESOStrategy(FitFunc &func,
 								 TParameters &parameters)
@@ -49,12 +58,19 @@ namespace libcmaes
 	_func = [&](const double *x, const int N) { return -1.0*_funcaux(x,N); };
       }
     _pfunc = [](const TParameters&,const TSolutions&){return 0;}; // high level progress function does do anything.
+    if (parameters._eval_cache_size > 0)
+      _evalcache = std::make_shared<EvalCache>(parameters._eval_cache_size,parameters._eval_cache_quantum);
+    if (parameters._crn)
+      _eval_context._seed = parameters.stream_seed(STREAM_CRN); // calls before the first generation, e.g. initial point.
+    if (!parameters._trace_file.empty())
+      set_tracer(std::make_shared<Tracer>());
     _solutions = TSolutions(_parameters);
     if (parameters._uh)
       {
 	std::random_device rd;
-	_uhgen = std::mt19937(rd());
+	_uhgen = std::mt19937(parameters._deterministic ? parameters.stream_seed(STREAM_UH) : rd());
 	_uhunif = std::uniform_real_distribution<>(0,1);
+	_uhesolver.set_stream(parameters._deterministic ? parameters.stream_seed(STREAM_UH_MUTATION) : rd());
       }
   }
 
@@ -65,12 +81,19 @@ namespace libcmaes
     :_func(func),_nevals(0),_niter(0),_parameters(parameters)
   {
     _pfunc = [](const TParameters&,const TSolutions&){return 0;}; // high level progress function does do anything.
+    if (parameters._eval_cache_size > 0)
+      _evalcache = std::make_shared<EvalCache>(parameters._eval_cache_size,parameters._eval_cache_quantum);
+    if (parameters._crn)
+      _eval_context._seed = parameters.stream_seed(STREAM_CRN); // calls before the first generation, e.g. initial point.
+    if (!parameters._trace_file.empty())
+      set_tracer(std::make_shared<Tracer>());
     start_from_solution(solutions);
     if (parameters._uh)
       {
 	std::random_device rd;
-	_uhgen = std::mt19937(rd());
+	_uhgen = std::mt19937(parameters._deterministic ? parameters.stream_seed(STREAM_UH) : rd());
 	_uhunif = std::uniform_real_distribution<>(0,1);
+	_uhesolver.set_stream(parameters._deterministic ? parameters.stream_seed(STREAM_UH_MUTATION) : rd());
       }
   }
   
@@ -83,27 +106,40 @@ namespace libcmaes
   void ESOStrategy<TParameters,TSolutions,TStopCriteria>::eval(const dMat &candidates,
 							       const dMat &phenocandidates)
   {
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstart = std::chrono::system_clock::now();
-#endif
+    PhaseTimer ptimer(_solutions._timers,PHASE_EVAL,_tracer.get());
     // one candidate per row.
-#pragma omp parallel for if (_parameters._mt_feval)
+    int nhits = 0;
+#pragma omp parallel for if (_parameters._mt_feval) reduction(+:nhits)
     for (int r=0;r<candidates.cols();r++)
       {
 	_solutions._candidates.at(r).set_x(candidates.col(r));
 	_solutions._candidates.at(r).set_id(r);
+	bool hit = false;
+	Tracer::clock::time_point tstart;
+	if (_tracer)
+	  tstart = Tracer::clock::now();
 	if (phenocandidates.size())
-	  _solutions._candidates.at(r).set_fvalue(_func(phenocandidates.col(r).data(),candidates.rows()));
-	else _solutions._candidates.at(r).set_fvalue(_func(candidates.col(r).data(),candidates.rows()));
+	  _solutions._candidates.at(r).set_fvalue(fcall(phenocandidates.col(r).data(),candidates.rows(),hit));
+	else _solutions._candidates.at(r).set_fvalue(fcall(candidates.col(r).data(),candidates.rows(),hit));
+	if (_tracer)
+	  _tracer->span(hit ? "fcall_cached" : "fcall",tstart,r,_solutions._candidates.at(r).get_fvalue());
+	if (hit)
+	  ++nhits;
 	
 	//std::cerr << "candidate x: " << _solutions._candidates.at(r)._x.transpose() << std::endl;
       }
-    int nfcalls = candidates.cols();
+    int nfcalls = candidates.cols() - nhits;
+    if (_evalcache)
+      {
+	_solutions._cache_hits += nhits;
+	_solutions._cache_misses += nfcalls;
+      }
     
     // evaluation step of uncertainty handling scheme.
     if (_parameters._uh)
       {
-				perform_uh(candidates,phenocandidates,nfcalls);
+	PhaseTimer utimer(_solutions._timers,PHASE_UH_EVAL,_tracer.get());
+	perform_uh(candidates,phenocandidates,nfcalls);
       }
 
     // if an elitist is active, reinject initial solution as needed.
@@ -141,11 +177,6 @@ namespace libcmaes
       }
     
     update_fevals(nfcalls);
-    
-#ifdef HAVE_DEBUG
-    std::chrono::time_point<std::chrono::system_clock> tstop = std::chrono::system_clock::now();
-    _solutions._elapsed_eval = std::chrono::duration_cast<std::chrono::milliseconds>(tstop-tstart).count();
-#endif
   }
 
   template<class TParameters,class TSolutions,class TStopCriteria>
@@ -162,6 +193,96 @@ namespace libcmaes
     _solutions._nevals += evals;
   }
 
+  template<class TParameters,class TSolutions,class TStopCriteria>
+  double ESOStrategy<TParameters,TSolutions,TStopCriteria>::fcall(const double *x, const int &N, bool &hit)
+  {
+    if (!_evalcache)
+      {
+	hit = false;
+	return func_call(x,N);
+      }
+    // values depend on the context seed with common random numbers, so is the key.
+    return _evalcache->eval([this](const double *x, const int &N){ return func_call(x,N); },x,N,hit,_eval_context._seed);
+  }
+
+  template<class TParameters,class TSolutions,class TStopCriteria>
+  double ESOStrategy<TParameters,TSolutions,TStopCriteria>::func_call(const double *x, const int &N)
+  {
+    set_eval_context(_eval_context);
+    return _func(x,N);
+  }
+
+  template<class TParameters,class TSolutions,class TStopCriteria>
+  void ESOStrategy<TParameters,TSolutions,TStopCriteria>::next_eval_context()
+  {
+    ++_eval_context._generation;
+    _eval_context._seed = _parameters._crn ? _parameters.stream_seed(STREAM_CRN,_eval_context._generation+1) : 0;
+  }
+  
+  template<class TParameters,class TSolutions,class TStopCriteria>
+  void ESOStrategy<TParameters,TSolutions,TStopCriteria>::update_fevals_cached(const bool &hit)
+  {
+    if (_evalcache)
+      ++(hit ? _solutions._cache_hits : _solutions._cache_misses);
+    if (!hit)
+      update_fevals(1);
+  }
+
+  template<class TParameters,class TSolutions,class TStopCriteria>
+  void ESOStrategy<TParameters,TSolutions,TStopCriteria>::put_state(CheckpointOut &out) const
+  {
+    out.put(_nevals);
+    out.put(_niter);
+    out.put(_initial_elitist);
+    out.put(_eval_context._generation);
+    out.put(_eval_context._seed);
+    std::ostringstream uhstate; // standard library generators and distributions only have a text state.
+    uhstate << _uhgen << ' ' << _uhunif;
+    out.put(uhstate.str());
+    out.put(_uhesolver.rng_state());
+    std::vector<uint64_t> cache;
+    if (_evalcache)
+      _evalcache->save(cache);
+    out.put(cache);
+  }
+
+  template<class TParameters,class TSolutions,class TStopCriteria>
+  std::function<void()> ESOStrategy<TParameters,TSolutions,TStopCriteria>::get_state(CheckpointIn &in)
+  {
+    int nevals = 0, niter = 0;
+    bool initial_elitist = false;
+    EvalContext eval_context = _eval_context;
+    std::string uhstate, uhrng;
+    std::vector<uint64_t> cache;
+    in.get(nevals);
+    in.get(niter);
+    in.get(initial_elitist);
+    in.get(eval_context._generation);
+    in.get(eval_context._seed);
+    in.get(uhstate);
+    in.get(uhrng);
+    in.get(cache);
+    std::mt19937 uhgen;
+    std::uniform_real_distribution<> uhunif;
+    std::istringstream uhin(uhstate);
+    uhin >> uhgen >> uhunif;
+    if (!in.good() || uhin.fail() || !Eigen::EigenMultivariateNormal<double>().set_rng_state(uhrng)
+	|| cache.size() != (_evalcache ? _evalcache->state_size() : 0))
+      return nullptr;
+    return [=]()
+      {
+	_nevals = nevals;
+	_niter = niter;
+	_initial_elitist = initial_elitist;
+	_eval_context = eval_context;
+	_uhgen = uhgen;
+	_uhunif = uhunif;
+	_uhesolver.set_rng_state(uhrng);
+	if (_evalcache)
+	  _evalcache->load(cache);
+      };
+  }
+
   template<class TParameters,class TSolutions,class TStopCriteria>
   dVec ESOStrategy<TParameters,TSolutions,TStopCriteria>::gradf(const dVec &x)
   {
@@ -169,14 +290,14 @@ namespace libcmaes
       return _gfunc(x.data(),_parameters._dim);
     dVec vgradf(_parameters._dim);
     dVec epsilon = 1e-8 * (dVec::Constant(_parameters._dim,1.0) + x.cwiseAbs());
-    double fx = _func(x.data(),_parameters._dim);
+    double fx = func_call(x.data(),_parameters._dim); // bypasses the cache, as finite differences are below its quantization step.
 #pragma omp parallel for if (_parameters._mt_feval)
     for (int i=0;i<_parameters._dim;i++)
       {
 	dVec ei1 = x;
 	ei1(i,0) += epsilon(i);
 	ei1(i,0) = std::min(ei1(i,0),_parameters.get_gp().get_boundstrategy_ref().getUBound(i));
-	double gradi = (_func(ei1.data(),_parameters._dim) - fx)/epsilon(i);
+	double gradi = (func_call(ei1.data(),_parameters._dim) - fx)/epsilon(i);
 	vgradf(i,0) = gradi;
       }
     update_fevals(_parameters._dim+1); // numerical gradient increases the budget.
@@ -360,15 +481,27 @@ namespace libcmaes
   template<class TParameters,class TSolutions,class TStopCriteria>
   void ESOStrategy<TParameters,TSolutions,TStopCriteria>::eval_candidates_uh(const dMat& candidates, const dMat& candidates_uh, std::vector<RankedCandidate>& nvcandidates, int& nfcalls)
 	{
-	// re-evaluate
+	// re-evaluate, in parallel as in eval(), into preallocated slots so that ordering is deterministic.
+	// Re-evaluations measure the noise and bypass the cache.
+	int nreev = std::min(_solutions._lambda_reev,static_cast<int>(candidates.cols()));
+	std::vector<double> nfvalues(nreev);
+#pragma omp parallel for if (_parameters._mt_feval)
+	for (int r=0;r<nreev;r++)
+	  {
+	    Tracer::clock::time_point tstart;
+	    if (_tracer)
+	      tstart = Tracer::clock::now();
+	    nfvalues[r] = func_call(candidates_uh.col(r).data(),candidates_uh.rows());
+	    if (_tracer)
+	      _tracer->span("fcall_reeval",tstart,r,nfvalues[r]);
+	  }
+	nfcalls += nreev;
+
+	nvcandidates.reserve(candidates.cols());
 	for (int r=0;r<candidates.cols();r++)
 	  {
-	    if (r < _solutions._lambda_reev)
-	      {
-		double nfvalue = _func(candidates_uh.col(r).data(),candidates_uh.rows());
-		nvcandidates.emplace_back(nfvalue,_solutions._candidates.at(r),r);
-		nfcalls++;
-	      }
+	    if (r < nreev)
+	      nvcandidates.emplace_back(nfvalues[r],_solutions._candidates.at(r),r);
 	    else nvcandidates.emplace_back(_solutions._candidates.at(r).get_fvalue(),_solutions._candidates.at(r),r);
 	  }
 	}
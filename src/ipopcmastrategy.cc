@@ -23,6 +23,12 @@
 #include <libcmaes/opti_err.h>
 #include <libcmaes/llogging.h>
 #include <iostream>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <limits>
 
 namespace libcmaes
 {
@@ -31,6 +37,8 @@ namespace libcmaes
 								 CMAParameters<TGenoPheno> &parameters)
     :CMAStrategy<TCovarianceUpdate,TGenoPheno>(func,parameters)
   {
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_put_restarts = std::bind(&IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::put_restarts,this,std::placeholders::_1);
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_get_restarts = std::bind(&IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::get_restarts,this,std::placeholders::_1);
   }
 
   template <class TCovarianceUpdate, class TGenoPheno>
@@ -39,6 +47,8 @@ namespace libcmaes
 								 const CMASolutions &solutions)
     :CMAStrategy<TCovarianceUpdate,TGenoPheno>(func,parameters,solutions)
   {
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_put_restarts = std::bind(&IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::put_restarts,this,std::placeholders::_1);
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_get_restarts = std::bind(&IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::get_restarts,this,std::placeholders::_1);
   }
 
   template <class TCovarianceUpdate, class TGenoPheno>
@@ -57,14 +67,38 @@ namespace libcmaes
 							      const AskFunc &askf,
 							      const TellFunc &tellf)
   {
-    CMASolutions best_run;
-    for (int r=0;r<CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._nrestarts;r++)
+    if (CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._nislands > 1)
       {
-	LOG_IF(INFO,!(CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._quiet)) << "r: " << r << " / lambda=" << CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda << std::endl;
+	int r = 0;
+	double lambda = CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda;
+	return optimize_islands([this,&r,&lambda](CMAParameters<TGenoPheno> &p, int &regime)
+				{
+				  if (r >= p._nrestarts)
+				    return static_cast<int>(ISLAND_DONE);
+				  p._lambda = lambda;
+				  p.initialize_parameters();
+				  p._seed += r;
+				  regime = r;
+				  LOG_IF(INFO,!p._quiet) << "r: " << r << " / lambda=" << p._lambda << std::endl;
+				  lambda *= 2.0;
+				  ++r;
+				  return static_cast<int>(ISLAND_RUN);
+				},
+				[](const CMAParameters<TGenoPheno>&, const int&, const CMASolutions&){});
+      }
+    
+    if (!CMAStrategy<TCovarianceUpdate,TGenoPheno>::_resumed) // otherwise continues the checkpointed restart.
+      {
+	_restart = 0;
+	_best_run = CMASolutions();
+      }
+    for (;_restart<CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._nrestarts;_restart++)
+      {
+	LOG_IF(INFO,!(CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._quiet)) << "r: " << _restart << " / lambda=" << CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters._lambda << std::endl;
 	CMAStrategy<TCovarianceUpdate,TGenoPheno>::optimize(evalf,askf,tellf);
 		
 	// capture best solution.
-	capture_best_solution(best_run);
+	capture_best_solution(_best_run);
 	
 	// reset parameters and solutions.
 	lambda_inc();
@@ -78,7 +112,7 @@ namespace libcmaes
 	    break;
 	  }
       }
-    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions = best_run;
+    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions = _best_run;
     if (CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions._run_status >= 0)
       return OPTI_SUCCESS;
     return OPTI_ERR_TERMINATION; // exact termination code is in CMAStrategy<TCovarianceUpdate>::_solutions._run_status.
@@ -95,8 +129,77 @@ namespace libcmaes
   template <class TCovarianceUpdate, class TGenoPheno>
   void IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::reset_search_state()
   {
-    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions = CMASolutions(CMAStrategy<TCovarianceUpdate,TGenoPheno>::_parameters);
-    CMAStrategy<TCovarianceUpdate,TGenoPheno>::_niter = 0;
+    typedef CMAStrategy<TCovarianceUpdate,TGenoPheno> cmastrat;
+    CMASolutions prev_solutions = std::move(cmastrat::_solutions);
+    cmastrat::_solutions = CMASolutions(cmastrat::_parameters);
+    cmastrat::_niter = 0;
+    // warm restart, not from a failed or empty run.
+    if (cmastrat::_parameters._warm_restarts && prev_solutions._niter > 0 && prev_solutions._run_status >= 0)
+      warm_start(cmastrat::_parameters,cmastrat::_solutions,prev_solutions);
+  }
+
+  template <class TCovarianceUpdate, class TGenoPheno>
+  void IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::warm_start(CMAParameters<TGenoPheno> &parameters,
+								 CMASolutions &solutions,
+								 const CMASolutions &prev_solutions)
+  {
+    double dim = static_cast<double>(parameters._dim);
+    
+    // covariance, eigenvalues to the power cexp, then rescaled to unit mean eigenvalue.
+    if (prev_solutions._cov.size() && solutions._cov.size())
+      {
+	Eigen::SelfAdjointEigenSolver<dMat> eigensolver(prev_solutions._cov);
+	dVec eigenvalues = eigensolver.eigenvalues().cwiseMax(std::numeric_limits<double>::min()).array().pow(parameters._warm_cexp).matrix();
+	eigenvalues *= dim / eigenvalues.sum();
+	solutions._cov = eigensolver.eigenvectors() * eigenvalues.asDiagonal() * eigensolver.eigenvectors().transpose();
+      }
+    else if (prev_solutions._sepcov.size() && solutions._sepcov.size())
+      {
+	solutions._sepcov = prev_solutions._sepcov.cwiseMax(std::numeric_limits<double>::min()).array().pow(parameters._warm_cexp).matrix();
+	if (parameters._vd) // D holds standard deviations.
+	  {
+	    solutions._sepcov *= std::sqrt(dim / solutions._sepcov.squaredNorm());
+	    solutions._v = parameters._warm_cexp * prev_solutions._v;
+	  }
+	else solutions._sepcov *= dim / solutions._sepcov.sum();
+      }
+    if (!solutions._cov.allFinite() || !solutions._sepcov.allFinite() || !solutions._v.allFinite())
+      {
+	LOG_IF(INFO,!parameters._quiet) << "Restart => warm start failed on non finite covariance, starting cold\n";
+	solutions = CMASolutions(parameters);
+	return;
+      }
+    
+    // mean, from the best point found so far and the fresh initial point.
+    if (parameters._warm_mix > 0.0 && prev_solutions._best_seen_candidate.get_x_size())
+      {
+	solutions._xmean = parameters._warm_mix * prev_solutions._best_seen_candidate.get_x_dvec()
+	  + (1.0 - parameters._warm_mix) * solutions._xmean; // fixed parameters share their value in both points.
+      }
+    LOG_IF(INFO,!parameters._quiet) << "Restart => warm start / cexp=" << parameters._warm_cexp << " / mix=" << parameters._warm_mix << std::endl;
+  }
+
+  template <class TCovarianceUpdate, class TGenoPheno>
+  void IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::put_restarts(CheckpointOut &out) const
+  {
+    out.put(_restart);
+    Checkpoint::put(out,_best_run);
+  }
+
+  template <class TCovarianceUpdate, class TGenoPheno>
+  std::function<void()> IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::get_restarts(CheckpointIn &in)
+  {
+    int restart = 0;
+    CMASolutions best_run = _best_run;
+    in.get(restart);
+    Checkpoint::get(in,best_run);
+    if (!in.good())
+      return nullptr;
+    return [=]()
+      {
+	_restart = restart;
+	_best_run = best_run;
+      };
   }
 
   template <class TCovarianceUpdate, class TGenoPheno>
@@ -106,6 +209,151 @@ namespace libcmaes
       best_run = CMAStrategy<TCovarianceUpdate,TGenoPheno>::_solutions;
   }
 
+  template <class TCovarianceUpdate, class TGenoPheno>
+  int IPOPCMAStrategy<TCovarianceUpdate,TGenoPheno>::optimize_islands(const IslandNextFunc &next,
+								      const IslandDoneFunc &done,
+								      const IslandProgressFunc &progress)
+  {
+    typedef CMAStrategy<TCovarianceUpdate,TGenoPheno> cmastrat;
+    const CMAParameters<TGenoPheno> &parameters = cmastrat::_parameters;
+    std::mutex mtx; // protects the scheduler state, the best candidate and run, and the progress function.
+    std::condition_variable cv;
+    std::atomic<int> nevals(0);
+    int running = 0;
+    bool stop = false; // no more islands are launched once set.
+    Candidate best_seen; // best candidate found so far by any island, live, for migration and the target.
+    const CMASolutions *best_seen_island = nullptr; // solutions of the island that found best_seen, it does not migrate back there.
+    CMASolutions best_run; // best completed island run, the final result.
+
+    // islands share the objective function, that is already negated when maximizing.
+    FitFunc ifunc = [this,&nevals](const double *x, const int N)
+      {
+	++nevals;
+	return cmastrat::_func(x,N);
+      };
+    auto budget_exhausted = [&parameters,&nevals]()
+      {
+	return parameters._max_fevals > 0 && nevals >= parameters._max_fevals;
+      };
+    auto ipfunc = [&](const CMAParameters<TGenoPheno> &p, const CMASolutions &s, const int &regime)
+      {
+	std::lock_guard<std::mutex> lock(mtx);
+	Candidate sbest = s.get_best_seen_candidate();
+	if (sbest.get_x_size() && (!best_seen.get_x_size() || sbest.get_fvalue() < best_seen.get_fvalue()))
+	  {
+	    best_seen = sbest;
+	    best_seen_island = &s;
+	  }
+	if (progress)
+	  {
+	    progress(p,regime,s);
+	    cv.notify_all(); // waiting islands may start now.
+	  }
+	if (!stop)
+	  stop = cmastrat::_pfunc(p,s) || budget_exhausted() // shared budget.
+	    || (best_seen.get_x_size() && best_seen.get_fvalue() <= parameters._ftarget); // an island reached the target.
+	return stop ? 1 : 0;
+      };
+
+#pragma omp parallel num_threads(parameters._nislands)
+    {
+      while(true)
+	{
+	  CMAParameters<TGenoPheno> iparameters;
+	  int regime = 0;
+	  std::unique_ptr<cmastrat> island;
+	  {
+	    std::unique_lock<std::mutex> lock(mtx);
+	    int status = ISLAND_DONE;
+	    while(true)
+	      {
+		iparameters = parameters;
+		if (stop || budget_exhausted())
+		  status = ISLAND_DONE;
+		else status = next(iparameters,regime);
+		if (status != ISLAND_WAIT || running == 0)
+		  break;
+		cv.wait(lock);
+	      }
+	    if (status != ISLAND_RUN)
+	      {
+		cv.notify_all();
+		break;
+	      }
+	    iparameters._nislands = 1;
+	    iparameters._maximize = false; // done by ifunc already.
+	    iparameters._fplot = ""; // islands cannot share the output file.
+	    iparameters._trace_file = ""; // islands record into the enclosing timeline instead.
+	    iparameters._checkpoint_file = ""; // islands run concurrently, no single state to checkpoint.
+	    island.reset(new cmastrat(ifunc,iparameters)); // under lock, initial mean sampling is not thread-safe.
+	    if (parameters._warm_restarts && best_run._niter > 0 && best_run._run_status >= 0) // warm start from the best completed run.
+	      warm_start(iparameters,island->get_solutions(),best_run);
+	    island->set_tracer(cmastrat::_tracer);
+	    ProgressFunc<CMAParameters<TGenoPheno>,CMASolutions> ripfunc = [&ipfunc,regime](const CMAParameters<TGenoPheno> &p, const CMASolutions &s)
+	      {
+		return ipfunc(p,s,regime);
+	      };
+	    island->set_progress_func(ripfunc);
+	    ++running;
+	  }
+
+	  // migration: replaces the worst candidate with the best candidate found so far by another island, running or not,
+	  // when better than the whole population.
+	  // A given elite migrates only once per island, repeated injection would stall the island's progress and trigger tolHistFun.
+	  double migrated = std::numeric_limits<double>::max();
+	  EvalFunc ievalf = [&](const dMat &candidates, const dMat &phenocandidates)
+	    {
+	      island->eval(candidates,phenocandidates);
+	      if (!parameters._islands_migration)
+		return;
+	      Candidate elite;
+	      {
+		std::lock_guard<std::mutex> lock(mtx);
+		if (!best_seen.get_x_size() || best_seen_island == &island->get_solutions())
+		  return;
+		elite = best_seen;
+	      }
+	      std::vector<Candidate> &icandidates = island->get_solutions().candidates();
+	      auto cmp = [](const Candidate &c1, const Candidate &c2){ return c1.get_fvalue() < c2.get_fvalue(); };
+	      auto worst = std::max_element(icandidates.begin(),icandidates.end(),cmp);
+	      if (elite.get_x_size() != (*worst).get_x_size()
+		  || elite.get_fvalue() >= migrated
+		  || elite.get_fvalue() >= (*std::min_element(icandidates.begin(),icandidates.end(),cmp)).get_fvalue())
+		return;
+	      migrated = elite.get_fvalue();
+	      int id = (*worst).get_id();
+	      *worst = elite;
+	      (*worst).set_id(id);
+	    };
+	  island->optimize(ievalf,
+			   std::bind(&cmastrat::ask,island.get()),
+			   std::bind(&cmastrat::tell,island.get()));
+
+	  {
+	    std::lock_guard<std::mutex> lock(mtx);
+	    --running;
+	    const CMASolutions &isols = island->get_solutions();
+	    done(iparameters,regime,isols);
+	    if (best_seen_island == &isols) // the address may be reused by a later island.
+	      best_seen_island = nullptr;
+	    if (best_run._candidates.empty() || isols.best_candidate().get_fvalue() < best_run.best_candidate().get_fvalue())
+	      best_run = isols;
+	    if (best_run.best_candidate().get_fvalue() <= parameters._ftarget)
+	      stop = true;
+	  }
+	  cv.notify_all();
+	}
+    }
+
+    if (budget_exhausted())
+      LOG_IF(INFO,!parameters._quiet) << "Island restarts ended on max fevals=" << nevals << ">=" << parameters._max_fevals << std::endl;
+    cmastrat::_nevals = nevals;
+    cmastrat::_solutions = best_run;
+    if (cmastrat::_solutions._run_status >= 0)
+      return OPTI_SUCCESS;
+    return OPTI_ERR_TERMINATION;
+  }
+
   template class CMAES_EXPORT IPOPCMAStrategy<CovarianceUpdate,GenoPheno<NoBoundStrategy>>;
   template class CMAES_EXPORT IPOPCMAStrategy<ACovarianceUpdate,GenoPheno<NoBoundStrategy>>;
   template class CMAES_EXPORT IPOPCMAStrategy<VDCMAUpdate,GenoPheno<NoBoundStrategy>>;
@@ -37,7 +37,9 @@ namespace libcmaes
     _l = std::floor(30*std::sqrt(eostrat<TGenoPheno>::_parameters.dim()));
     eostrat<TGenoPheno>::_pfunc = [this](const CMAParameters<TGenoPheno> &cmaparams, const CMASolutions &cmasols)
       {
-	LOG_IF(INFO,!cmaparams.quiet()) << "iter=" << cmasols.niter() << " / evals=" << cmasols.fevals() << " / f-value=" << cmasols.best_candidate().get_fvalue() <<  " / sigma=" << cmasols.sigma() << " / trainerr=" << _train_err << " / testerr=" << _test_err << " / smtesterr=" << _smooth_test_err << std::endl;
+	if (cmaparams.get_log_kv())
+	  LOG_IF(INFO,cmaparams.log_due(cmasols.niter())) << "iter=" << cmasols.niter() << " evals=" << cmasols.fevals() << " fvalue=" << cmasols.best_candidate().get_fvalue() << " sigma=" << cmasols.sigma() << " trainerr=" << _train_err << " testerr=" << _test_err << " smtesterr=" << _smooth_test_err << std::endl;
+	else LOG_IF(INFO,cmaparams.log_due(cmasols.niter())) << "iter=" << cmasols.niter() << " / evals=" << cmasols.fevals() << " / f-value=" << cmasols.best_candidate().get_fvalue() <<  " / sigma=" << cmasols.sigma() << " / trainerr=" << _train_err << " / testerr=" << _test_err << " / smtesterr=" << _smooth_test_err << std::endl;
 	return 0;
       };
     eostrat<TGenoPheno>::_pffunc = [this](const CMAParameters<TGenoPheno> &cmaparams, const CMASolutions &cmasols, std::ofstream &fplotstream)
@@ -112,7 +114,9 @@ namespace libcmaes
   {
     eostrat<TGenoPheno>::_pfunc = [this](const CMAParameters<TGenoPheno> &cmaparams, const CMASolutions &cmasols)
       {
-	LOG_IF(INFO,!cmaparams.quiet()) << "iter=" << cmasols.niter() << " / evals=" << cmasols.fevals() << " / f-value=" << cmasols.best_candidate().get_fvalue() <<  " / sigma=" << cmasols.sigma() << " / trainerr=" << this->_train_err << " / testerr=" << this->_test_err << " / smtesterr=" << this->_smooth_test_err << " / slifel=" << this->_nsteps << std::endl;
+	if (cmaparams.get_log_kv())
+	  LOG_IF(INFO,cmaparams.log_due(cmasols.niter())) << "iter=" << cmasols.niter() << " evals=" << cmasols.fevals() << " fvalue=" << cmasols.best_candidate().get_fvalue() << " sigma=" << cmasols.sigma() << " trainerr=" << this->_train_err << " testerr=" << this->_test_err << " smtesterr=" << this->_smooth_test_err << " slifel=" << this->_nsteps << std::endl;
+	else LOG_IF(INFO,cmaparams.log_due(cmasols.niter())) << "iter=" << cmasols.niter() << " / evals=" << cmasols.fevals() << " / f-value=" << cmasols.best_candidate().get_fvalue() <<  " / sigma=" << cmasols.sigma() << " / trainerr=" << this->_train_err << " / testerr=" << this->_test_err << " / smtesterr=" << this->_smooth_test_err << " / slifel=" << this->_nsteps << std::endl;
 	return 0;
       };
     this->_stopcriteria.set_criteria_active(STAGNATION,false); // deactivate stagnation check due to the presence of ranks as median objective function values
@@ -215,8 +219,16 @@ namespace libcmaes
   template<template <class U,class V> class TStrategy, class TCovarianceUpdate, class TGenoPheno>
   void ACMSurrogateStrategy<TStrategy,TCovarianceUpdate,TGenoPheno>::init_rd()
   {
-    _gen0 = std::mt19937(_rd());
-    _gen1 = std::mt19937(_rd());
+    if (eostrat<TGenoPheno>::_parameters._deterministic)
+      {
+	_gen0 = std::mt19937(eostrat<TGenoPheno>::_parameters.stream_seed(STREAM_SURROGATE,0));
+	_gen1 = std::mt19937(eostrat<TGenoPheno>::_parameters.stream_seed(STREAM_SURROGATE,1));
+      }
+    else
+      {
+	_gen0 = std::mt19937(_rd());
+	_gen1 = std::mt19937(_rd());
+      }
     _norm_sel0 = std::normal_distribution<double>(0.0,_theta_sel0*_theta_sel0);
     _norm_sel1 = std::normal_distribution<double>(0.0,_theta_sel1*_theta_sel1);
   }
@@ -360,8 +372,9 @@ namespace libcmaes
     std::vector<Candidate> test_set;
     std::sort(ncandidates.begin(),ncandidates.end(),
 	      [](Candidate const &c1, Candidate const &c2){return c1.get_fvalue() < c2.get_fvalue();});
-    ncandidates.at(0).set_fvalue(this->_func(eostrat<TGenoPheno>::_parameters._gp.pheno(ncandidates.at(0).get_x_dvec()).data(),ncandidates.at(0).get_x_size()));
-    this->update_fevals(1);
+    bool hit = false;
+    ncandidates.at(0).set_fvalue(this->fcall(eostrat<TGenoPheno>::_parameters._gp.pheno(ncandidates.at(0).get_x_dvec()).data(),ncandidates.at(0).get_x_size(),hit));
+    this->update_fevals_cached(hit);
     test_set.push_back(ncandidates.at(0));
     this->add_to_training_set(ncandidates.at(0));
     int count = 1;
@@ -375,11 +388,11 @@ namespace libcmaes
 	if (a < (int)ncandidates.size() && (uhit=uh.find(a))==uh.end())
 	  {
 	    uh.insert(a);
-	    double fvalue = this->_func(eostrat<TGenoPheno>::_parameters._gp.pheno(ncandidates.at(a).get_x_dvec()).data(),ncandidates.at(a).get_x_size());
+	    double fvalue = this->fcall(eostrat<TGenoPheno>::_parameters._gp.pheno(ncandidates.at(a).get_x_dvec()).data(),ncandidates.at(a).get_x_size(),hit);
 	    ncandidates.at(a).set_fvalue(fvalue);
 	    test_set.push_back(ncandidates.at(a));
 	    this->add_to_training_set(ncandidates.at(a));
-	    this->update_fevals(1);
+	    this->update_fevals_cached(hit);
 	    ++count;
 	  }
       }
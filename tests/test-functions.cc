@@ -478,6 +478,7 @@ DEFINE_bool(all,false,"test on all functions");
 DEFINE_double(epsilon,1e-10,"epsilon on function result testing, with --all");
 DEFINE_string(fplot,"","file where to store data for later plotting of results and internal states");
 DEFINE_bool(full_fplot,false,"whether to activate full legacy plot");
+DEFINE_bool(fplot_binary,false,"whether to write the plot file in the binary format, see python/cma_fplot.py");
 DEFINE_double(sigma0,-1.0,"initial value for step-size sigma (-1.0 for automated value)");
 DEFINE_double(x0,-std::numeric_limits<double>::max(),"initial value for all components of the mean vector (-DBL_MAX for automated value)");
 DEFINE_uint64(seed,0,"seed for random generator");
@@ -487,6 +488,11 @@ DEFINE_bool(lazy_update,false,"covariance lazy update");
 DEFINE_double(lbound,std::numeric_limits<double>::max()/-1e2,"lower bound to parameter vector");
 DEFINE_double(ubound,std::numeric_limits<double>::max()/1e2,"upper bound to parameter vector");
 DEFINE_bool(quiet,false,"no intermediate output");
+DEFINE_int32(log_every,1,"number of iterations between two progress lines");
+DEFINE_bool(log_kv,false,"whether progress lines are key=value pairs");
+DEFINE_string(checkpoint,"","file where to periodically store the search state, for resuming with -resume");
+DEFINE_int32(checkpoint_every,100,"number of iterations between two checkpoints");
+DEFINE_bool(resume,false,"whether to resume from the -checkpoint file, when it exists");
 DEFINE_bool(le,false,"whether to return profile likelihood error bounds around the minimum");
 DEFINE_double(le_fup,0.1,"deviation from the minimum as the size of the confidence interval for profile likelihood computation");
 DEFINE_double(le_delta,0.1,"tolerance factor around the fup confidence interval for profile likelihood computation");
@@ -516,6 +522,11 @@ DEFINE_bool(no_tolupsigma,false,"deactivate tolupsigma stopping criteria");
 DEFINE_bool(uh,false,"activate uncertainty handling of objective function");
 DEFINE_int32(tpa,1,"whether to use two-point adapation for step-size update, 0: no, 1: auto, 2: yes");
 DEFINE_double(tpa_dsigma,-1,"set two-point adaptation dsigma (use with care)");
+DEFINE_bool(warm_restarts,false,"whether restarts inherit the shape of the previous covariance matrix, applies to IPOP and BIPOP algorithms");
+DEFINE_double(warm_cexp,1.0,"exponent applied to the inherited eigenvalues on warm restarts, in [0,1]");
+DEFINE_double(warm_mix,0.0,"weight of the previous best point in the initial mean of warm restarts, in [0,1]");
+DEFINE_bool(warm_bench,false,"benchmarks cold vs warm restarts on all functions with known solution, as expected running time to reach the optimum within epsilon");
+DEFINE_int32(warm_bench_runs,10,"number of runs per function and restart policy, with --warm_bench");
 
 template <class TGenoPheno=GenoPheno<NoBoundStrategy,NoScalingStrategy>>
 CMASolutions cmaes_opt()
@@ -540,8 +551,13 @@ CMASolutions cmaes_opt()
   cmaparams.set_restarts(FLAGS_restarts);
   cmaparams.set_fplot(FLAGS_fplot);
   cmaparams.set_full_fplot(FLAGS_full_fplot);
+  cmaparams.set_fplot_binary(FLAGS_fplot_binary);
   cmaparams.set_lazy_update(FLAGS_lazy_update);
   cmaparams.set_quiet(FLAGS_quiet);
+  cmaparams.set_log_every(FLAGS_log_every);
+  cmaparams.set_log_kv(FLAGS_log_kv);
+  cmaparams.set_checkpoint(FLAGS_checkpoint,FLAGS_checkpoint_every);
+  cmaparams.set_resume(FLAGS_resume);
   cmaparams.set_tpa(FLAGS_tpa);
   cmaparams.set_gradient(FLAGS_with_gradient || FLAGS_with_num_gradient);
   cmaparams.set_edm(FLAGS_with_edm);
@@ -550,6 +566,9 @@ CMASolutions cmaes_opt()
   cmaparams.set_elitism(FLAGS_elitist);
   cmaparams.set_max_hist(FLAGS_max_hist);
   cmaparams.set_uh(FLAGS_uh);
+  cmaparams.set_warm_restarts(FLAGS_warm_restarts);
+  cmaparams.set_warm_restarts_cexp(FLAGS_warm_cexp);
+  cmaparams.set_warm_restarts_mix(FLAGS_warm_mix);
   if (FLAGS_tpa_dsigma > 0.0)
     cmaparams.set_tpa_dsigma(FLAGS_tpa_dsigma);
   if (FLAGS_ftarget != -std::numeric_limits<double>::infinity())
@@ -718,6 +737,55 @@ int main(int argc, char *argv[])
 	}
       exit(1);
     }
+  else if (FLAGS_warm_bench)
+    {
+      if (FLAGS_alg != "ipop" && FLAGS_alg != "bipop" && FLAGS_alg != "aipop" && FLAGS_alg != "abipop")
+	{
+	  LOG(ERROR) << "warm restarts benchmark requires a restart algorithm, among ipop, bipop, aipop, abipop\n";
+	  exit(-1);
+	}
+      std::cout << "function / policy / successes / ERT (fevals to target) / mean best f-value\n";
+      for (mit=mfuncs.begin();mit!=mfuncs.end();++mit)
+	{
+	  if ((fmit=msols.find((*mit).first))==msols.end())
+	    continue;
+	  for (int warm=0;warm<2;warm++)
+	    {
+	      int nsuccesses = 0;
+	      long int nevals = 0;
+	      double mean_fvalue = 0.0;
+	      for (int r=0;r<FLAGS_warm_bench_runs;r++)
+		{
+		  int dim = (*fmit).second.get_x_dvec().rows();
+		  std::vector<double> x0(dim,FLAGS_x0);
+		  CMAParameters<> cmaparams(x0,FLAGS_sigma0,FLAGS_lambda);
+		  if ((pmit=mparams.find((*mit).first))!=mparams.end())
+		    cmaparams = (*pmit).second;
+		  cmaparams.set_seed(FLAGS_seed + r + 1); // same seeds for both policies.
+		  cmaparams.set_quiet(true);
+		  cmaparams.set_max_fevals(FLAGS_max_fevals);
+		  cmaparams.set_restarts(FLAGS_restarts);
+		  cmaparams.set_ftarget((*fmit).second.get_fvalue() + FLAGS_epsilon);
+		  cmaparams.set_algo(FLAGS_alg == "ipop" ? IPOP_CMAES : FLAGS_alg == "bipop" ? BIPOP_CMAES : FLAGS_alg == "aipop" ? aIPOP_CMAES : aBIPOP_CMAES);
+		  cmaparams.set_warm_restarts(warm == 1);
+		  cmaparams.set_warm_restarts_cexp(FLAGS_warm_cexp);
+		  cmaparams.set_warm_restarts_mix(FLAGS_warm_mix);
+		  int fevals = 0;
+		  FitFunc func = (*mit).second;
+		  FitFunc cfunc = [&fevals,&func](const double *x, const int N) { ++fevals; return func(x,N); };
+		  CMASolutions cmasols = cmaes<>(cfunc,cmaparams);
+		  nevals += fevals;
+		  mean_fvalue += cmasols.best_candidate().get_fvalue() / FLAGS_warm_bench_runs;
+		  if (cmasols.best_candidate().get_fvalue() <= cmaparams.get_ftarget())
+		    ++nsuccesses;
+		}
+	      std::cout << (*mit).first << " / " << (warm ? "warm" : "cold") << " / " << nsuccesses << "/" << FLAGS_warm_bench_runs
+			<< " / " << (nsuccesses ? nevals / static_cast<double>(nsuccesses) : std::numeric_limits<double>::infinity())
+			<< " / " << mean_fvalue << std::endl;
+	    }
+	}
+      exit(1);
+    }
   
   if ((mit=mfuncs.find(FLAGS_fname))==mfuncs.end())
     {
@@ -0,0 +1,128 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libcmaes/cmaes.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace libcmaes;
+
+int ncalls = 0;
+
+FitFunc rastrigin = [](const double *x, const int N)
+{
+  ++ncalls;
+  double val = 10.0*N;
+  for (int i=0;i<N;i++)
+    val += x[i]*x[i] - 10.0*cos(2*M_PI*x[i]);
+  return val;
+};
+
+CMAParameters<> make_parameters(const int &algo, const std::string &checkpoint="", const int &every=1)
+{
+  std::vector<double> x0(10,1.5);
+  CMAParameters<> cmaparams(x0,1.0,-1,1234);
+  cmaparams.set_algo(algo);
+  cmaparams.set_quiet(true);
+  cmaparams.set_max_fevals(20000);
+  cmaparams.set_restarts(3);
+  cmaparams.set_deterministic(true);
+  if (!checkpoint.empty())
+    cmaparams.set_checkpoint(checkpoint,every);
+  return cmaparams;
+}
+
+void expect_identical(const CMASolutions &s1, const CMASolutions &s2)
+{
+  ASSERT_EQ(s1.run_status(),s2.run_status());
+  ASSERT_EQ(s1.niter(),s2.niter());
+  ASSERT_EQ(s1.fevals(),s2.fevals());
+  ASSERT_EQ(s1.sigma(),s2.sigma());
+  ASSERT_EQ(s1.best_candidate().get_fvalue(),s2.best_candidate().get_fvalue());
+  ASSERT_TRUE(s1.xmean() == s2.xmean());
+  ASSERT_TRUE(s1.cov() == s2.cov());
+}
+
+// checkpoints every k iterations, then resumes from the last checkpoint into a fresh
+// strategy that must finish exactly as an uninterrupted run.
+template<class TStrategy>
+void check_resume(const int &algo, const int &k)
+{
+  std::string checkpoint = "ut_checkpoint_" + std::to_string(algo) + ".ck";
+  std::remove(checkpoint.c_str());
+  CMAParameters<> refparams = make_parameters(algo);
+  ESOptimizer<TStrategy,CMAParameters<>> ref(rastrigin,refparams);
+  ref.optimize();
+  {
+    CMAParameters<> cmaparams = make_parameters(algo,checkpoint,k);
+    ESOptimizer<TStrategy,CMAParameters<>> optim(rastrigin,cmaparams);
+    optim.optimize();
+  } // the last checkpoint is written on destruction.
+  CMAParameters<> cmaparams = make_parameters(algo,checkpoint,k);
+  cmaparams.set_resume(true);
+  ESOptimizer<TStrategy,CMAParameters<>> optim(rastrigin,cmaparams);
+  ncalls = 0;
+  ASSERT_EQ(OPTI_SUCCESS,optim.optimize());
+  ASSERT_GT(ncalls,0); // the checkpoint is not the last iteration.
+  expect_identical(ref.get_solutions(),optim.get_solutions());
+  std::remove(checkpoint.c_str());
+}
+
+TEST(checkpoint,cmaes_resume)
+{
+  check_resume<CMAStrategy<CovarianceUpdate>>(CMAES_DEFAULT,7);
+}
+
+TEST(checkpoint,ipop_resume)
+{
+  check_resume<IPOPCMAStrategy<CovarianceUpdate,GenoPheno<NoBoundStrategy>>>(IPOP_CMAES,7);
+}
+
+TEST(checkpoint,bipop_resume)
+{
+  check_resume<BIPOPCMAStrategy<CovarianceUpdate,GenoPheno<NoBoundStrategy>>>(BIPOP_CMAES,7);
+}
+
+TEST(checkpoint,corrupted_leaves_state)
+{
+  std::string checkpoint = "ut_checkpoint_corrupted.ck";
+  {
+    CMAParameters<> cmaparams = make_parameters(CMAES_DEFAULT,checkpoint,10);
+    cmaparams.set_max_iter(50);
+    ESOptimizer<CMAStrategy<CovarianceUpdate>,CMAParameters<>> optim(rastrigin,cmaparams);
+    optim.optimize();
+  }
+  std::vector<char> buf;
+  ASSERT_TRUE(Checkpoint::read_file(checkpoint,buf));
+  std::ofstream(checkpoint,std::ios::binary).write(buf.data(),buf.size()-16); // truncated.
+
+  CMAParameters<> refparams = make_parameters(CMAES_DEFAULT);
+  ESOptimizer<CMAStrategy<CovarianceUpdate>,CMAParameters<>> ref(rastrigin,refparams);
+  ref.optimize();
+  CMAParameters<> cmaparams = make_parameters(CMAES_DEFAULT);
+  ESOptimizer<CMAStrategy<CovarianceUpdate>,CMAParameters<>> optim(rastrigin,cmaparams);
+  ASSERT_EQ(OPTI_ERR_CHECKPOINT,optim.resume(checkpoint));
+  optim.optimize(); // runs from the initial state, as if resume() had not been called.
+  expect_identical(ref.get_solutions(),optim.get_solutions());
+  std::remove(checkpoint.c_str());
+}
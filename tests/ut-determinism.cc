@@ -0,0 +1,92 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <libcmaes/cmaes.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace libcmaes;
+
+FitFunc rastrigin = [](const double *x, const int N)
+{
+  double val = 10.0*N;
+  for (int i=0;i<N;i++)
+    val += x[i]*x[i] - 10.0*cos(2*M_PI*x[i]);
+  return val;
+};
+
+CMASolutions run_deterministic(const int &algo, const int &nthreads, const bool &uh, const bool &sep=false)
+{
+#ifdef _OPENMP
+  omp_set_num_threads(nthreads);
+#endif
+  Eigen::setNbThreads(nthreads);
+  int dim = 10;
+  std::vector<double> x0(dim,-std::numeric_limits<double>::max()); // random initial mean.
+  CMAParameters<> cmaparams(x0,1.0,-1,1234);
+  cmaparams.set_algo(algo);
+  if (sep)
+    cmaparams.set_sep();
+  cmaparams.set_quiet(true);
+  cmaparams.set_mt_feval(true);
+  cmaparams.set_uh(uh);
+  cmaparams.set_max_fevals(20000);
+  cmaparams.set_restarts(3);
+  cmaparams.set_deterministic(true);
+  return cmaes<>(rastrigin,cmaparams);
+}
+
+void expect_identical(const CMASolutions &s1, const CMASolutions &s2)
+{
+  ASSERT_EQ(s1.run_status(),s2.run_status());
+  ASSERT_EQ(s1.niter(),s2.niter());
+  ASSERT_EQ(s1.fevals(),s2.fevals());
+  ASSERT_EQ(s1.sigma(),s2.sigma());
+  ASSERT_EQ(s1.best_candidate().get_fvalue(),s2.best_candidate().get_fvalue());
+  ASSERT_TRUE(s1.best_candidate().get_x_dvec() == s2.best_candidate().get_x_dvec());
+  ASSERT_TRUE(s1.xmean() == s2.xmean());
+  ASSERT_TRUE(s1.cov() == s2.cov());
+  ASSERT_TRUE(s1.sepcov() == s2.sepcov());
+}
+
+TEST(deterministic,cmaes_threads)
+{
+  CMASolutions s1 = run_deterministic(CMAES_DEFAULT,1,false);
+  expect_identical(s1,run_deterministic(CMAES_DEFAULT,4,false));
+  expect_identical(s1,run_deterministic(CMAES_DEFAULT,32,false));
+}
+
+TEST(deterministic,sepcmaes_uh_threads)
+{
+  CMASolutions s1 = run_deterministic(sepCMAES,1,true,true);
+  expect_identical(s1,run_deterministic(sepCMAES,4,true,true));
+  expect_identical(s1,run_deterministic(sepCMAES,32,true,true));
+}
+
+TEST(deterministic,bipop_threads)
+{
+  CMASolutions s1 = run_deterministic(BIPOP_CMAES,1,false);
+  expect_identical(s1,run_deterministic(BIPOP_CMAES,4,false));
+  expect_identical(s1,run_deterministic(BIPOP_CMAES,32,false));
+}
@@ -0,0 +1,118 @@
+/**
+ * CMA-ES, Covariance Matrix Adaptation Evolution Strategy
+ * Copyright (c) 2014 Inria
+ * Author: Emmanuel Benazera <emmanuel.benazera@lri.fr>
+ *
+ * This file is part of libcmaes.
+ *
+ * libcmaes is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libcmaes is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with libcmaes.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "evalcache.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <iostream>
+
+using namespace libcmaes;
+
+double sphere(const double *x, const int N)
+{
+  double val = 0.0;
+  for (int i=0;i<N;i++)
+    val += x[i]*x[i];
+  return val;
+}
+
+TEST(evalcache,hit_miss)
+{
+  EvalCache cache(64);
+  int calls = 0;
+  auto func = [&calls](const double *x, const int N) { ++calls; return sphere(x,N); };
+  double x[3] = {1.0,-2.0,0.5};
+  bool hit;
+  ASSERT_EQ(5.25,cache.eval(func,x,3,hit));
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(5.25,cache.eval(func,x,3,hit));
+  ASSERT_TRUE(hit);
+  ASSERT_EQ(1,calls);
+  x[2] = 0.25;
+  cache.eval(func,x,3,hit);
+  ASSERT_FALSE(hit);
+  cache.eval(func,x,3,hit,42); // other salt.
+  ASSERT_FALSE(hit);
+  ASSERT_EQ(3,calls);
+  ASSERT_EQ(1,cache.hits());
+  ASSERT_EQ(3,cache.misses());
+}
+
+TEST(evalcache,inactive)
+{
+  EvalCache cache(0);
+  ASSERT_FALSE(cache.active());
+  double x[2] = {1.0,1.0};
+  bool hit;
+  cache.eval(sphere,x,2,hit);
+  cache.eval(sphere,x,2,hit);
+  ASSERT_FALSE(hit);
+}
+
+TEST(evalcache,slot_collision)
+{
+  EvalCache cache(1); // a single slot, all keys collide.
+  double x1[2] = {1.0,2.0}, x2[2] = {3.0,4.0};
+  uint64_t k1 = cache.key(x1,2), k2 = cache.key(x2,2);
+  ASSERT_NE(k1,k2);
+  double fvalue;
+  cache.put(k1,5.0);
+  ASSERT_TRUE(cache.get(k1,fvalue));
+  ASSERT_EQ(5.0,fvalue);
+  ASSERT_FALSE(cache.get(k2,fvalue));
+  cache.put(k2,25.0);
+  ASSERT_FALSE(cache.get(k1,fvalue)); // replaced.
+  ASSERT_TRUE(cache.get(k2,fvalue));
+  ASSERT_EQ(25.0,fvalue);
+}
+
+TEST(evalcache,quantized_keys)
+{
+  EvalCache cache(64,0.1);
+  double x1[2] = {1.0,-0.0}, x2[2] = {1.01,0.0}, x3[2] = {1.1,0.0};
+  ASSERT_EQ(cache.key(x1,2),cache.key(x2,2));
+  ASSERT_NE(cache.key(x1,2),cache.key(x3,2));
+  double big[3] = {1e300,-1e300,std::numeric_limits<double>::infinity()};
+  double big2[3] = {1e300,-1e300,-std::numeric_limits<double>::infinity()};
+  ASSERT_NE(cache.key(big,3),cache.key(big2,3));
+  ASSERT_EQ(cache.key(big,3),cache.key(big,3));
+}
+
+TEST(evalcache,concurrent)
+{
+  EvalCache cache(256);
+  const int npoints = 1024, nrounds = 20, dim = 4;
+  int errors = 0;
+#pragma omp parallel for reduction(+:errors)
+  for (int r=0;r<nrounds*npoints;r++)
+    {
+      double x[dim];
+      for (int i=0;i<dim;i++)
+	x[i] = (r % npoints) + 0.1*i;
+      bool hit;
+      double fvalue = cache.eval(sphere,x,dim,hit);
+      if (fvalue != sphere(x,dim))
+	++errors;
+    }
+  ASSERT_EQ(0,errors);
+  ASSERT_EQ(nrounds*npoints,cache.hits()+cache.misses());
+  ASSERT_GT(cache.hits(),0);
+}